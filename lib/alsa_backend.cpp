@@ -0,0 +1,285 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/alsa_backend.hpp"
+#include "audio++/error.hpp"
+#include "audio++/vector.hpp"
+#include "seqlock.hpp"
+
+#include <alsa/asoundlib.h>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+constexpr auto to_alsa_format(audio::type type)
+{
+    switch (type)
+    {
+        case u8 : return SND_PCM_FORMAT_U8;
+        case s16: return SND_PCM_FORMAT_S16;
+        case s24: return SND_PCM_FORMAT_S24_3LE;
+        case s32: return SND_PCM_FORMAT_S32;
+        case f32: return SND_PCM_FORMAT_FLOAT;
+        case s24_32: return SND_PCM_FORMAT_S24_LE;
+        default : return SND_PCM_FORMAT_UNKNOWN;
+    }
+}
+
+auto pcm_open_helper(const std::string& name, audio::stream dir, int mode)
+{
+    snd_pcm_t* pcm;
+    auto ev = snd_pcm_open(&pcm, name.data(),
+        dir == stream::capture ? SND_PCM_STREAM_CAPTURE : SND_PCM_STREAM_PLAYBACK,
+    mode);
+    if (ev) throw alsa_error{ev, "snd_pcm_open()"};
+    return pcm;
+}
+
+auto create_params_helper(snd_pcm_t* pcm)
+{
+    snd_pcm_hw_params_t* params;
+
+    auto ev = snd_pcm_hw_params_malloc(&params);
+    if (ev) throw alsa_error{ev, "snd_pcm_hw_params_malloc()"};
+
+    ev = snd_pcm_hw_params_any(pcm, params);
+    if (ev)
+    {
+        snd_pcm_hw_params_free(params);
+        throw alsa_error{ev, "snd_pcm_hw_params_any()"};
+    }
+
+    return params;
+}
+
+void set_params_helper(snd_pcm_t* pcm, const snd_pcm_hw_params_t* any, audio::format fmt, std::size_t period)
+{
+    std::unique_ptr<snd_pcm_hw_params_t, void(*)(snd_pcm_hw_params_t*)> params{
+        create_params_helper(pcm), &snd_pcm_hw_params_free
+    };
+    snd_pcm_hw_params_copy(&*params, any);
+
+    auto ev = snd_pcm_hw_params_set_access(pcm, &*params, SND_PCM_ACCESS_RW_INTERLEAVED);
+    if (ev) throw alsa_error{ev, "snd_pcm_hw_params_set_access()"};
+
+    ev = snd_pcm_hw_params_set_format(pcm, &*params, to_alsa_format(fmt.type));
+    if (ev) throw alsa_error{ev, "snd_pcm_hw_params_set_format()"};
+
+    ev = snd_pcm_hw_params_set_channels(pcm, &*params, fmt.chans);
+    if (ev) throw alsa_error{ev, "snd_pcm_hw_params_set_channels()"};
+
+    ev = snd_pcm_hw_params_set_rate(pcm, &*params, fmt.rate, 0);
+    if (ev) throw alsa_error{ev, "snd_pcm_hw_params_set_rate()"};
+
+    snd_pcm_uframes_t size = period;
+    ev = snd_pcm_hw_params_set_period_size_near(pcm, &*params, &size, nullptr);
+    if (ev) throw alsa_error{ev, "snd_pcm_hw_params_set_period_size_near()"};
+
+    size *= 3;
+    ev = snd_pcm_hw_params_set_buffer_size_near(pcm, &*params, &size);
+    if (ev) throw alsa_error{ev, "snd_pcm_hw_params_set_buffer_size_near()"};
+
+    ev = snd_pcm_hw_params(pcm, &*params);
+    if (ev) throw alsa_error{ev, "snd_pcm_hw_params()"};
+}
+
+void set_sw_params_helper(snd_pcm_t* pcm)
+{
+    snd_pcm_sw_params_t* p;
+
+    auto ev = snd_pcm_sw_params_malloc(&p);
+    if (ev) throw alsa_error{ev, "snd_pcm_sw_params_malloc()"};
+    std::unique_ptr<snd_pcm_sw_params_t, void(*)(snd_pcm_sw_params_t*)> params{ p, &snd_pcm_sw_params_free };
+
+    ev = snd_pcm_sw_params_current(pcm, &*params);
+    if (ev) throw alsa_error{ev, "snd_pcm_sw_params_current()"};
+
+    // have the driver take high-resolution timestamps on CLOCK_MONOTONIC
+    ev = snd_pcm_sw_params_set_tstamp_mode(pcm, &*params, SND_PCM_TSTAMP_ENABLE);
+    if (ev) throw alsa_error{ev, "snd_pcm_sw_params_set_tstamp_mode()"};
+
+    ev = snd_pcm_sw_params_set_tstamp_type(pcm, &*params, SND_PCM_TSTAMP_TYPE_MONOTONIC);
+    if (ev) throw alsa_error{ev, "snd_pcm_sw_params_set_tstamp_type()"};
+
+    ev = snd_pcm_sw_params(pcm, &*params);
+    if (ev) throw alsa_error{ev, "snd_pcm_sw_params()"};
+}
+
+auto create_status_helper()
+{
+    snd_pcm_status_t* status;
+
+    auto ev = snd_pcm_status_malloc(&status);
+    if (ev) throw alsa_error{ev, "snd_pcm_status_malloc()"};
+
+    return std::unique_ptr<snd_pcm_status_t, void(*)(snd_pcm_status_t*)>{ status, &snd_pcm_status_free };
+}
+
+constexpr auto to_duration(const snd_htimestamp_t& ts)
+{
+    return std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec};
+}
+
+constexpr auto to_time_point(const snd_htimestamp_t& ts)
+{
+    return timestamp::clock::time_point{ std::chrono::duration_cast<timestamp::clock::duration>(to_duration(ts)) };
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+alsa_backend::alsa_backend(std::string name, audio::stream stream, int mode) :
+    name_{std::move(name)}, stream_{stream},
+    pcm_{ pcm_open_helper(name_, stream, mode), &snd_pcm_close },
+    params_{ create_params_helper(&*pcm_), &snd_pcm_hw_params_free },
+    timestamp_{ std::make_unique<seqlock>(sizeof(audio::timestamp)) }
+{ }
+
+alsa_backend::alsa_backend(std::string name, audio::stream stream) :
+    alsa_backend{std::move(name), stream, 0}
+{ }
+
+alsa_backend::alsa_backend(std::string name, audio::stream stream, nonblock_t) :
+    alsa_backend{std::move(name), stream, SND_PCM_NONBLOCK}
+{ }
+
+alsa_backend::~alsa_backend() { join(); }
+
+////////////////////////////////////////////////////////////////////////////////
+bool alsa_backend::test(audio::rate rate) const
+{
+    return !snd_pcm_hw_params_test_rate(&*pcm_, &*params_, rate, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void alsa_backend::start(audio::format fmt, std::size_t period, callback cb)
+{
+    // errors of the previous run are of no interest anymore
+    join();
+    error_ = nullptr;
+    failed_ = false;
+
+    set_params_helper(&*pcm_, &*params_, fmt, period);
+    set_sw_params_helper(&*pcm_);
+
+    auto ev = snd_pcm_prepare(&*pcm_);
+    if (ev) throw alsa_error{ev, "snd_pcm_prepare()"};
+
+    stop_ = false;
+    has_timestamp_ = false;
+    thread_ = std::thread{&alsa_backend::run, this, fmt, period, std::move(cb)};
+}
+
+void alsa_backend::stop()
+{
+    join();
+    if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+}
+
+void alsa_backend::join()
+{
+    if (thread_.joinable())
+    {
+        stop_ = true;
+        thread_.join();
+        snd_pcm_drop(&*pcm_);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void alsa_backend::run(audio::format fmt, std::size_t period, callback cb) try
+{
+    auto pcm = &*pcm_;
+    audio::vector buffer{fmt, period};
+
+    auto status = create_status_helper();
+    std::uint64_t position = 0;
+
+    while (!stop_)
+    {
+        if (stream_ == stream::playback) cb(buffer.span(0));
+
+        auto data = buffer.as_bytes().data();
+        snd_pcm_uframes_t done = 0;
+
+        while (done < period && !stop_)
+        {
+            auto frame = data + done * fmt.size();
+            auto count = stream_ == stream::playback ?
+                snd_pcm_writei(pcm, frame, period - done) :
+                snd_pcm_readi(pcm, frame, period - done);
+
+            if (count == -EAGAIN) snd_pcm_wait(pcm, 100);
+            else if (count < 0)
+            {
+                // xrun or suspend; give up on anything else
+                auto ev = snd_pcm_recover(pcm, static_cast<int>(count), 1);
+                if (ev) throw alsa_error{ev, "snd_pcm_recover()"};
+            }
+            else done += count;
+        }
+
+        position += done;
+        update_timestamp(&*status, fmt.rate, position);
+
+        if (stream_ == stream::capture && done == period) cb(buffer.span(0));
+    }
+}
+catch (...)
+{
+    // handed over to stop(), which joins this thread first
+    error_ = std::current_exception();
+    failed_.store(true, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void alsa_backend::update_timestamp(snd_pcm_status_t* status, audio::rate rate, std::uint64_t position)
+{
+    // ask for the delay to be included in the audio timestamp
+    snd_pcm_audio_tstamp_config_t config{ };
+    config.type_requested = SND_PCM_AUDIO_TSTAMP_TYPE_DEFAULT;
+    config.report_delay = stream_ == stream::playback;
+    snd_pcm_status_set_audio_htstamp_config(status, &config);
+
+    if (snd_pcm_status(&*pcm_, status)) return;
+
+    snd_htimestamp_t trigger, time, audio_time;
+    snd_pcm_status_get_trigger_htstamp(status, &trigger);
+    snd_pcm_status_get_htstamp(status, &time);
+    snd_pcm_status_get_audio_htstamp(status, &audio_time);
+
+    audio::timestamp ts;
+    ts.trigger = to_time_point(trigger);
+    ts.time = to_time_point(time);
+    ts.audio_time = to_duration(audio_time);
+    ts.position = position;
+    ts.delay = snd_pcm_status_get_delay(status);
+    ts.frame = stream_ == stream::playback ? position - ts.delay : position + ts.delay;
+    ts.rate = rate;
+
+    timestamp_->store(&ts);
+    has_timestamp_.store(true, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::optional<audio::timestamp> alsa_backend::timestamp() const
+{
+    if (!has_timestamp_.load(std::memory_order_acquire)) return std::nullopt;
+
+    audio::timestamp ts;
+    timestamp_->load(&ts);
+    return ts;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
@@ -5,10 +5,20 @@
 // Distributed under the GNU GPL license. See the LICENSE.md file for details.
 
 ////////////////////////////////////////////////////////////////////////////////
+#include <audio++/alsa_backend.hpp>
+#include <audio++/backend.hpp>
 #include <audio++/converter.hpp>
+#include <audio++/decoder.hpp>
 #include <audio++/device.hpp>
 #include <audio++/error.hpp>
+#include <audio++/meter.hpp>
+#include <audio++/mini_backend.hpp>
 #include <audio++/params.hpp>
+#include <audio++/scheduler.hpp>
+#include <audio++/shm.hpp>
+#include <audio++/silence.hpp>
 #include <audio++/span.hpp>
+#include <audio++/stft.hpp>
 #include <audio++/types.hpp>
 #include <audio++/vector.hpp>
+#include <audio++/virtual_backend.hpp>
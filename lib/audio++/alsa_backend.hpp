@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef AUDIO_ALSA_BACKEND_HPP
+#define AUDIO_ALSA_BACKEND_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/backend.hpp"
+#include "audio++/types.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <string>
+#include <thread>
+
+struct _snd_pcm;
+using snd_pcm_t = _snd_pcm;
+
+struct _snd_pcm_hw_params;
+using snd_pcm_hw_params_t = _snd_pcm_hw_params;
+
+struct _snd_pcm_status;
+using snd_pcm_status_t = _snd_pcm_status;
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+class seqlock;
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @class audio::alsa_backend
+ * @brief ALSA backend.
+ *
+ * Runs a thread doing blocking (or, in non-blocking mode, poll-driven)
+ * interleaved reads or writes of one period at a time. After each period it
+ * samples snd_pcm_status with monotonic high-resolution timestamps.
+ *
+ * If the device fails (eg, is unplugged) or the callback throws, the thread
+ * stops, failed() returns true and the exception is rethrown by stop().
+ */
+class alsa_backend : public backend
+{
+public:
+    ////////////////////
+    alsa_backend(std::string name, audio::stream);
+    alsa_backend(std::string name, audio::stream, nonblock_t);
+    ~alsa_backend() override;
+
+    const std::string& name() const noexcept override { return name_; }
+    audio::stream stream() const noexcept override { return stream_; }
+
+    bool test(rate) const override;
+
+    void start(audio::format, std::size_t period, callback) override;
+    void stop() override;
+
+    std::optional<audio::timestamp> timestamp() const override;
+
+    bool failed() const noexcept override { return failed_.load(std::memory_order_acquire); }
+
+private:
+    ////////////////////
+    alsa_backend(std::string name, audio::stream, int mode);
+
+    std::string name_;
+    audio::stream stream_;
+
+    std::unique_ptr<snd_pcm_t, int(*)(snd_pcm_t*)> pcm_;
+    std::unique_ptr<snd_pcm_hw_params_t, void(*)(snd_pcm_hw_params_t*)> params_;
+
+    std::thread thread_;
+    std::atomic<bool> stop_ = false;
+
+    std::exception_ptr error_;
+    std::atomic<bool> failed_ = false;
+
+    std::unique_ptr<seqlock> timestamp_;
+    std::atomic<bool> has_timestamp_ = false;
+
+    void join();
+    void run(audio::format, std::size_t period, callback);
+    void update_timestamp(snd_pcm_status_t*, audio::rate, std::uint64_t position);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
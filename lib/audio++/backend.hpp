@@ -0,0 +1,102 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef AUDIO_BACKEND_HPP
+#define AUDIO_BACKEND_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/span.hpp"
+#include "audio++/types.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @enum audio::stream
+ * @brief Stream direction.
+ */
+enum class stream : int { capture, playback };
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @struct audio::timestamp
+ * @brief Stream status sampled once per period.
+ *
+ * All times are on CLOCK_MONOTONIC (std::chrono::steady_clock).
+ *
+ * position is the count of frames transferred by the application since the
+ * stream was started, delay is the count of frames between the application
+ * and the device (ie, queued for playback or captured but not read yet), and
+ * frame is the position at the device itself as of time.
+ */
+struct timestamp
+{
+    using clock = std::chrono::steady_clock;
+
+    clock::time_point trigger, time;
+    std::chrono::nanoseconds audio_time;
+
+    std::uint64_t position, frame;
+    std::int64_t delay;
+    audio::rate rate;
+
+    // map a frame position to the time it was or will be played or captured
+    constexpr auto time_of(std::uint64_t pos) const noexcept
+    {
+        // split into seconds and remainder to avoid overflow
+        auto frames = static_cast<std::int64_t>(pos - frame);
+        return time + std::chrono::seconds{frames / rate} + std::chrono::nanoseconds{frames % rate * 1'000'000'000 / rate};
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @class audio::backend
+ * @brief Base class for audio device backends.
+ *
+ * Once started, the backend invokes the callback from its audio thread once
+ * per period with a span, which the callback has to fill (playback) or
+ * consume (capture).
+ */
+class backend
+{
+public:
+    ////////////////////
+    using callback = std::function<void(span)>;
+
+    virtual ~backend() = default;
+
+    virtual const std::string& name() const noexcept = 0;
+    virtual audio::stream stream() const noexcept = 0;
+
+    virtual bool test(rate) const = 0;
+
+    virtual void start(audio::format, std::size_t period, callback) = 0;
+    virtual void stop() = 0;
+
+    // latest timestamp (if supported); safe to call from any thread
+    virtual std::optional<audio::timestamp> timestamp() const { return std::nullopt; }
+
+    // whether the audio thread has stopped due to an error; the error itself
+    // is rethrown by stop()
+    virtual bool failed() const noexcept { return false; }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
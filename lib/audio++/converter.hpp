@@ -13,7 +13,10 @@
 #include "audio++/types.hpp"
 #include "audio++/vector.hpp"
 
+#include <cstddef>
+#include <cstdint>
 #include <memory>
+#include <span>
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace audio
@@ -31,7 +34,22 @@ public:
     ////////////////////
     explicit converter(const converter_options&);
 
-    vector process(span);
+    vector process(span data) { return process(data, false); }
+
+    // If silent is true (see audio::silence_detector), the resampler and
+    // conversion are skipped, and a silent block of the expected size is
+    // returned instead. The flag is not carried by the block itself, so the
+    // caller has to pass it on to the downstream stages (eg, to
+    // audio::stft::process and audio::meter::process).
+    vector process(span, bool silent);
+
+    // Batched versions, which process many small chunks in one pass.
+    //
+    // The second one converts into caller-provided spans, filling them in
+    // order, and returns the total count of frames written. Input that did
+    // not fit is kept for the next call.
+    vector process(std::span<const span>);
+    std::size_t process(std::span<const span>, std::span<span>);
 
 private:
     ////////////////////
@@ -41,6 +59,16 @@ private:
 
     audio::format fmt_in_, fmt_out_;
     audio::vector store_;
+
+    // running frame counts to keep output size in sync across silent blocks
+    std::uint64_t frames_in_ = 0, frames_out_ = 0;
+    bool silent_ = false;
+
+    void gather(std::span<const span>);
+    void append(span);
+    std::size_t expected(std::size_t count_in) const;
+    std::size_t drain(span);
+    void resume();
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,117 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef AUDIO_DECODER_HPP
+#define AUDIO_DECODER_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/span.hpp"
+#include "audio++/types.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @struct audio::decoder_options
+ * @brief Decoder options.
+ *
+ * fmt is the format to decode into. buffer is the size of the read-ahead
+ * buffer and chunk is the count of frames decoded at a time (both in frames).
+ * seek_points is the size of the seek table built for MP3 files when they are
+ * opened. WAV and FLAC files have their own.
+ */
+struct decoder_options
+{
+    audio::format fmt;
+    std::size_t buffer = 65536;
+    std::size_t chunk = 4096;
+    unsigned seek_points = 1024;
+};
+
+/**
+ * @class audio::decoder
+ * @brief Streaming WAV/FLAC/MP3 decoder with read-ahead.
+ *
+ * Decoding runs on a small pool of background threads shared by all decoders,
+ * which keeps their buffers full a chunk at a time. read() returns a view into
+ * the buffer, which stays valid until consume() is called. An empty view is
+ * returned while the pool is catching up (eg, right after a seek).
+ *
+ * read(), consume() and seek() may be called from the playback thread. They
+ * never wait for decoding, and only briefly lock the pool when an idle
+ * decoder has to be handed over to it.
+ *
+ * Seeking is sample-accurate.
+ */
+class decoder
+{
+public:
+    ////////////////////
+    decoder(const std::string& path, const decoder_options&);
+    ~decoder();
+
+    decoder(const decoder&) = delete;
+    decoder& operator=(const decoder&) = delete;
+
+    constexpr auto&& format() const noexcept { return fmt_; }
+    constexpr auto length() const noexcept { return length_; }
+
+    span read(std::size_t count = span::npos);
+    void consume(std::size_t count);
+
+    void seek(std::uint64_t frame);
+    constexpr auto position() const noexcept { return pos_; }
+
+    bool eof() const noexcept;
+
+private:
+    ////////////////////
+    audio::format fmt_;
+    std::size_t capacity_, chunk_;
+    std::uint64_t length_ = 0, pos_ = 0;
+
+    // ma_decoder is a typedef to an anonymous struct,
+    // so we can't forward-declare it and have to use void*
+    std::unique_ptr<void, void (*)(void*)> decoder_;
+
+    // single-producer single-consumer ring, positions are in frames
+    std::vector<char> ring_;
+    std::atomic<std::uint64_t> head_ = 0, tail_ = 0;
+
+    // seek requests and their completion
+    std::atomic<std::uint64_t> seek_to_ = 0, seek_head_ = 0;
+    std::atomic<unsigned> seek_gen_ = 0, done_gen_ = 0;
+    unsigned applied_gen_ = 0, gen_ = 0;
+
+    std::atomic<bool> eof_ = false;
+
+    // handover to the pool (see decoder::post)
+    enum : unsigned { queued = 1, busy = 2, dying = 4 };
+    std::atomic<unsigned> state_ = 0;
+
+    struct pool;
+    void post();
+    bool pending() const noexcept;
+    void fill();
+
+    bool seeking() noexcept;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
@@ -9,36 +9,49 @@
 #define AUDIO_DEVICE_HPP
 
 ////////////////////////////////////////////////////////////////////////////////
+#include "audio++/backend.hpp"
 #include "audio++/params.hpp"
 #include "audio++/types.hpp"
 
+#include <cstddef>
 #include <memory>
 #include <string>
 
-struct _snd_pcm;
-using snd_pcm_t = _snd_pcm;
-
 ////////////////////////////////////////////////////////////////////////////////
 namespace audio
 {
 
 ////////////////////////////////////////////////////////////////////////////////
+/**
+ * @class audio::device
+ * @brief Audio device.
+ *
+ * Devices opened by name or card number use the ALSA backend. Any other
+ * backend (see audio::mini_backend and audio::virtual_backend) can be passed
+ * in instead.
+ */
 class device
 {
 public:
     ////////////////////
-    auto&& name() const noexcept { return name_; }
+    auto&& name() const noexcept { return backend_->name(); }
     auto&& params() const noexcept { return params_; }
 
+    void start(audio::format fmt, std::size_t period, audio::backend::callback cb) { backend_->start(fmt, period, std::move(cb)); }
+    void stop() { backend_->stop(); }
+
+    auto timestamp() const { return backend_->timestamp(); }
+    bool failed() const noexcept { return backend_->failed(); }
+
 protected:
     ////////////////////
-    device(std::string name, int stream, int mode);
-    device(card c, int stream, int mode) : device{"hw:" + std::to_string(c), stream, mode} { }
+    device(std::unique_ptr<audio::backend>, audio::stream);
+
+    static std::string hw_name(card c) { return "hw:" + std::to_string(c); }
 
 private:
     ////////////////////
-    std::unique_ptr<snd_pcm_t, int(*)(snd_pcm_t*)> pcm_;
-    std::string name_;
+    std::unique_ptr<audio::backend> backend_;
     audio::params params_;
 };
 
@@ -52,6 +65,8 @@ public:
 
     capture(std::string name, nonblock_t);
     capture(card, nonblock_t);
+
+    explicit capture(std::unique_ptr<audio::backend>);
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -64,6 +79,8 @@ public:
 
     playback(std::string name, nonblock_t);
     playback(card, nonblock_t);
+
+    explicit playback(std::unique_ptr<audio::backend>);
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,106 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef AUDIO_METER_HPP
+#define AUDIO_METER_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/span.hpp"
+#include "audio++/types.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+class seqlock;
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @struct audio::level
+ * @brief Signal level of one channel.
+ *
+ * Peak and RMS are linear (1.0 = full scale) and cover the last 400 ms.
+ * Momentary (400 ms) and short-term (3 s) loudness are in LUFS as per
+ * EBU R128 and are -inf for digital silence.
+ */
+struct level
+{
+    float peak, rms;
+    float momentary, short_term;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @class audio::meter
+ * @brief Streaming peak, RMS and loudness meter.
+ *
+ * process() must be called from one thread only. levels() is lock-free and
+ * may be called from any thread. Levels are updated every 100 ms of audio.
+ */
+class meter
+{
+public:
+    ////////////////////
+    explicit meter(audio::format);
+    ~meter();
+
+    void process(span data) { process(data, false); }
+
+    // If silent is true (see audio::silence_detector), the span is accounted
+    // for as digital silence without looking at its samples.
+    void process(span, bool silent);
+
+    std::vector<level> levels() const;
+
+private:
+    ////////////////////
+    audio::format fmt_;
+    std::size_t block_, count_ = 0;
+
+    struct biquad
+    {
+        double b0, b1, b2, a1, a2;
+        double z1 = 0, z2 = 0;
+    };
+
+    struct block
+    {
+        float peak = 0;
+        double sq = 0, wsq = 0; // sum of squares (plain and K-weighted)
+    };
+
+    static constexpr std::size_t momentary_blocks = 4;
+    static constexpr std::size_t short_term_blocks = 30;
+
+    struct channel
+    {
+        biquad shelf, hipass;
+        block acc;
+        block hist[short_term_blocks];
+    };
+
+    std::vector<channel> chans_;
+    std::size_t hist_pos_ = 0;
+
+    std::vector<float> data_, plane_;
+    std::vector<level> levels_;
+    std::unique_ptr<seqlock> snapshot_;
+
+    void update(span);
+    void update(float* plane, std::size_t n, channel&);
+    void publish();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
@@ -0,0 +1,82 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef AUDIO_MINI_BACKEND_HPP
+#define AUDIO_MINI_BACKEND_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/backend.hpp"
+#include "audio++/types.hpp"
+#include "audio++/vector.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @class audio::mini_backend
+ * @brief miniaudio backend.
+ *
+ * Uses the ma_device callback engine on the default device of the default
+ * miniaudio backend. miniaudio converts to and from the device's native
+ * format and rate, so all rates are accepted.
+ *
+ * If the callback throws, the device keeps running but plays silence (or
+ * drops input), failed() returns true and the exception is rethrown by stop().
+ */
+class mini_backend : public backend
+{
+public:
+    ////////////////////
+    explicit mini_backend(audio::stream);
+    ~mini_backend() override;
+
+    const std::string& name() const noexcept override { return name_; }
+    audio::stream stream() const noexcept override { return stream_; }
+
+    bool test(rate) const override { return true; }
+
+    void start(audio::format, std::size_t period, callback) override;
+    void stop() override;
+
+    bool failed() const noexcept override { return failed_.load(std::memory_order_acquire); }
+
+private:
+    ////////////////////
+    std::string name_;
+    audio::stream stream_;
+
+    audio::format fmt_;
+    callback cb_;
+
+    // s24_32 capture data is narrowed here, as the buffer
+    // miniaudio hands over may be read-only
+    std::optional<audio::vector> scratch_;
+
+    std::exception_ptr error_;
+    std::atomic<bool> failed_ = false;
+
+    // ma_device is a typedef to an anonymous struct,
+    // so we can't forward-declare it and have to use void*
+    std::unique_ptr<void, void (*)(void*)> device_;
+
+    void process(void* out, const void* in, std::size_t count);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
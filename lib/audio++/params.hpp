@@ -10,18 +10,13 @@
 
 ////////////////////////////////////////////////////////////////////////////////
 #include "audio++/types.hpp"
-#include <memory>
-
-struct _snd_pcm;
-using snd_pcm_t = _snd_pcm;
-
-struct _snd_pcm_hw_params;
-using snd_pcm_hw_params_t = _snd_pcm_hw_params;
 
 ////////////////////////////////////////////////////////////////////////////////
 namespace audio
 {
 
+class backend;
+
 ////////////////////////////////////////////////////////////////////////////////
 class params
 {
@@ -31,10 +26,9 @@ public:
 
 private:
     ////////////////////
-    snd_pcm_t* pcm_;
-    std::unique_ptr<snd_pcm_hw_params_t, void(*)(snd_pcm_hw_params_t*)> params_;
+    const backend* backend_;
 
-    explicit params(snd_pcm_t*);
+    explicit params(const backend* b) : backend_{b} { }
     friend class device;
 };
 
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef AUDIO_SCHEDULER_HPP
+#define AUDIO_SCHEDULER_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/device.hpp"
+#include "audio++/span.hpp"
+#include "audio++/types.hpp"
+#include "audio++/vector.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @struct audio::scheduler_options
+ * @brief Playback scheduler options.
+ *
+ * period is the largest count of frames mixed at a time. Larger spans passed
+ * to process() are split up. capacity is the maximum count of clips that can
+ * be scheduled or playing at the same time.
+ */
+struct scheduler_options
+{
+    audio::format fmt;
+    std::size_t period = 1024;
+    std::size_t capacity = 1024;
+};
+
+/**
+ * @class audio::scheduler
+ * @brief Sample-accurate playback scheduler.
+ *
+ * Mixes clips into the output starting at exact frame positions, counted
+ * from the first call to process(). Clips scheduled in the past start right
+ * away.
+ *
+ * A clip is either an audio::vector or a source, which is called to fill the
+ * span it is given and returns the count of frames it has written. Returning
+ * fewer frames than asked for ends the clip.
+ *
+ * schedule() may be called from any thread. process() runs on the audio
+ * thread (see start()) and neither allocates, frees nor locks: new clips are
+ * handed over through a lock-free queue and pushed onto a min-heap keyed by
+ * their start position. Finished clips are handed back and destroyed by the
+ * next call to schedule() (or by the destructor).
+ */
+class scheduler
+{
+public:
+    ////////////////////
+    using source = std::function<std::size_t(span)>;
+
+    explicit scheduler(const scheduler_options&);
+    ~scheduler();
+
+    scheduler(const scheduler&) = delete;
+    scheduler& operator=(const scheduler&) = delete;
+
+    constexpr auto&& format() const noexcept { return fmt_; }
+
+    // return false if there are already capacity clips in flight
+    bool schedule(std::uint64_t start, audio::vector);
+    bool schedule(std::uint64_t start, source);
+
+    void start(audio::playback&);
+    void process(span);
+
+    auto position() const noexcept { return pos_.load(std::memory_order_acquire); }
+
+private:
+    ////////////////////
+    audio::format fmt_;
+    std::size_t period_;
+    std::atomic<std::uint64_t> pos_ = 0;
+
+    std::mutex mutex_; // serializes schedule() calls
+
+    struct clip;
+    struct state;
+    std::unique_ptr<state> state_;
+
+    bool submit(std::unique_ptr<clip>);
+    void mix(span);
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
@@ -0,0 +1,130 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef AUDIO_SHM_HPP
+#define AUDIO_SHM_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/span.hpp"
+#include "audio++/types.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+struct shm_header;
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @struct audio::shm_options
+ * @brief Shared-memory transport options.
+ *
+ * capacity is the size of the ring (in frames).
+ */
+struct shm_options
+{
+    audio::format fmt;
+    std::size_t capacity = 65536;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @class audio::shm_writer
+ * @brief Writing end of a shared-memory audio ring.
+ *
+ * The ring lives in a sealed memfd tagged with the audio format. The writer
+ * never blocks: readers that fall behind by more than the capacity lose data
+ * (see audio::shm_reader::consume).
+ *
+ * Each reader gets its own eventfd, which is signalled after every write.
+ * Both fd() and the eventfd returned by add_reader() have to be passed to the
+ * reader process (eg, via SCM_RIGHTS or fork). They remain owned by the writer.
+ */
+class shm_writer
+{
+public:
+    ////////////////////
+    explicit shm_writer(const shm_options&);
+    ~shm_writer();
+
+    shm_writer(const shm_writer&) = delete;
+    shm_writer& operator=(const shm_writer&) = delete;
+
+    constexpr auto&& format() const noexcept { return fmt_; }
+    constexpr auto fd() const noexcept { return fd_; }
+
+    int add_reader();
+
+    void write(span);
+
+private:
+    ////////////////////
+    audio::format fmt_;
+    int fd_;
+
+    shm_header* header_;
+    char* data_;
+    std::size_t size_;
+
+    std::vector<int> events_;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @class audio::shm_reader
+ * @brief Reading end of a shared-memory audio ring.
+ *
+ * read() returns a view directly into shared memory. Once done with it, call
+ * consume(), which returns false if the writer has overwritten the data in the
+ * meantime.
+ *
+ * Takes ownership of the memfd and the eventfd.
+ */
+class shm_reader
+{
+public:
+    ////////////////////
+    shm_reader(int fd, int event_fd);
+    ~shm_reader();
+
+    shm_reader(const shm_reader&) = delete;
+    shm_reader& operator=(const shm_reader&) = delete;
+
+    constexpr auto&& format() const noexcept { return fmt_; }
+    constexpr auto event_fd() const noexcept { return event_fd_; }
+
+    span read(std::size_t count = span::npos);
+    bool consume(std::size_t count);
+
+    // block until the writer signals new data
+    void wait();
+
+    constexpr auto overruns() const noexcept { return overruns_; }
+
+private:
+    ////////////////////
+    audio::format fmt_;
+    int fd_, event_fd_;
+
+    const shm_header* header_;
+    const char* data_;
+    std::size_t size_;
+    std::uint64_t capacity_;
+
+    std::uint64_t pos_;
+    std::uint64_t overruns_ = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
@@ -0,0 +1,65 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef AUDIO_SILENCE_HPP
+#define AUDIO_SILENCE_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/span.hpp"
+#include "audio++/types.hpp"
+
+#include <cstddef>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @struct audio::silence_options
+ * @brief Silence detector options.
+ *
+ * threshold is linear (1.0 = full scale); the default is about -60 dBFS.
+ * hangover is the number of quiet frames that still have to be passed through
+ * before the input is reported as silent. It should be longer than the
+ * latency of any stage downstream, so that their tails get flushed out.
+ */
+struct silence_options
+{
+    audio::format fmt;
+    float threshold = 0.001f;
+    std::size_t hangover = 4096;
+};
+
+/**
+ * @class audio::silence_detector
+ * @brief Cheap silence detector.
+ *
+ * process() returns true if the span is silent and can be skipped by the
+ * downstream stages (see audio::converter::process, audio::meter::process
+ * and audio::stft::process).
+ */
+class silence_detector
+{
+public:
+    ////////////////////
+    explicit silence_detector(const silence_options&);
+
+    bool process(span);
+
+private:
+    ////////////////////
+    audio::format fmt_;
+    float threshold_;
+    std::size_t hangover_, quiet_ = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
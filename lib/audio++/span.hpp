@@ -11,6 +11,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 #include "audio++/types.hpp"
 
+#include <algorithm>
 #include <cstddef>
 #include <span>
 
@@ -41,6 +42,17 @@ public:
     constexpr auto as_bytes() const noexcept { return std::span{ data_, size_bytes() }; }
     constexpr auto as_bytes() noexcept { return std::span{ data_, size_bytes() }; }
 
+    ////////////////////
+    static constexpr auto npos = static_cast<std::size_t>(-1);
+
+    constexpr auto subspan(std::size_t pos, std::size_t count = npos) const noexcept
+    {
+        pos = std::min(pos, size());
+        count = std::min(count, size() - pos);
+
+        return span{fmt_, data_ + pos * frame_size(), count};
+    }
+
 private:
     ////////////////////
     audio::format fmt_;
@@ -0,0 +1,97 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef AUDIO_STFT_HPP
+#define AUDIO_STFT_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/span.hpp"
+#include "audio++/types.hpp"
+
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <span>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @enum audio::window
+ * @brief STFT window function.
+ */
+enum window : int { rect, hann, hamming, blackman };
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @struct audio::stft_options
+ * @brief STFT options.
+ *
+ * size must be a power of 2 and hop must divide it. The same window is used
+ * for analysis and synthesis, so for perfect reconstruction its square must
+ * add up to a constant at the given hop (eg, hop = size / 4 for hann).
+ */
+struct stft_options
+{
+    audio::format fmt;
+    std::size_t size = 1024;
+    std::size_t hop = 256;
+    audio::window window = hann;
+};
+
+/**
+ * @class audio::stft
+ * @brief Streaming short-time Fourier transform with overlap-add resynthesis.
+ *
+ * Every hop frames the callback is invoked once per channel with size / 2 + 1
+ * bins of the current frame, which it may modify in place. Output is delayed
+ * by size frames.
+ *
+ * All buffers and FFT tables are allocated in the constructor, so process()
+ * does not allocate and may be called from a real-time thread.
+ */
+class stft
+{
+public:
+    ////////////////////
+    using bins = std::span<std::complex<float>>;
+    using callback = std::function<void(int chan, bins)>;
+
+    stft(const stft_options&, callback = { });
+    ~stft();
+
+    // in and out must be of the same format and size, and may be the same span
+    void process(span in, span out) { process(in, out, false); }
+
+    // If silent is true (see audio::silence_detector), the FFT is skipped and
+    // silence is written out. The detector's hangover should be longer than
+    // latency(), so that the tail of the preceding audio is already out.
+    void process(span in, span out, bool silent);
+
+    constexpr auto latency() const noexcept { return size_; }
+
+private:
+    ////////////////////
+    audio::format fmt_;
+    std::size_t size_, hop_, pos_ = 0;
+    callback cb_;
+    bool silent_ = false;
+
+    struct state;
+    std::unique_ptr<state> state_;
+
+    void process_frame();
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
@@ -45,10 +45,13 @@ constexpr auto operator"" _khz(long double n) noexcept { return static_cast<rate
 /**
  * @enum audio::type
  * @brief Type of audio samples.
+ *
+ * s24 is packed into 3 bytes, while s24_32 is stored in the lower 3 bytes of
+ * a 32-bit word. Both are little-endian.
  */
 enum type : int
 {
-    u8, s16, s24, s32, f32,
+    u8, s16, s24, s32, f32, s24_32,
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -62,7 +65,8 @@ constexpr std::size_t bits(audio::type type) noexcept
     {
     case u8 : return 8;
     case s16: return 16;
-    case s24: return 24;
+    case s24:
+    case s24_32: return 24;
     case s32:
     case f32: return 32;
     }
@@ -79,7 +83,8 @@ constexpr std::size_t size(audio::type type) noexcept
     {
         case u8 : return 1;
         case s16: return 2;
-        case s24:
+        case s24: return 3;
+        case s24_32:
         case s32:
         case f32: return 4;
     }
@@ -50,6 +50,8 @@ public:
         return audio::span{fmt_, data_.data() + pos * frame_size(), count};
     }
 
+    void resize(std::size_t count) { data_.resize(count * frame_size()); }
+
     void append(audio::span span)
     {
         assert(span.format() == format());
@@ -0,0 +1,95 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef AUDIO_VIRTUAL_BACKEND_HPP
+#define AUDIO_VIRTUAL_BACKEND_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/backend.hpp"
+#include "audio++/span.hpp"
+#include "audio++/types.hpp"
+#include "audio++/vector.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+class seqlock;
+
+////////////////////////////////////////////////////////////////////////////////
+/**
+ * @class audio::virtual_backend
+ * @brief In-process device driven by a simulated clock.
+ *
+ * Nothing happens in real time: each call to advance() moves the clock
+ * forward and invokes the callback synchronously for every period that has
+ * elapsed. This makes end-to-end latency and throughput measurements
+ * deterministic and independent of sound hardware.
+ *
+ * A capture device delivers data queued with feed() and silence after that.
+ * A playback device records everything the callback has produced.
+ *
+ * Timestamps are derived from the simulated clock, which starts at the epoch
+ * of std::chrono::steady_clock, and have no delay. As with other backends,
+ * they may be read from any thread while another one calls advance().
+ */
+class virtual_backend : public backend
+{
+public:
+    ////////////////////
+    explicit virtual_backend(audio::stream, std::string name = "virtual");
+    ~virtual_backend() override;
+
+    const std::string& name() const noexcept override { return name_; }
+    audio::stream stream() const noexcept override { return stream_; }
+
+    bool test(rate) const override { return true; }
+
+    void start(audio::format, std::size_t period, callback) override;
+    void stop() override;
+
+    std::optional<audio::timestamp> timestamp() const override;
+
+    ////////////////////
+    void advance(std::size_t frames);
+    constexpr auto now() const noexcept { return clock_; }
+
+    void feed(span);
+    auto&& recorded() const noexcept { return recorded_; }
+
+private:
+    ////////////////////
+    std::string name_;
+    audio::stream stream_;
+
+    std::size_t period_ = 0;
+    audio::rate rate_{ };
+    callback cb_;
+
+    std::uint64_t clock_ = 0, next_ = 0; // frames
+    std::optional<audio::vector> buffer_, input_, recorded_;
+    std::size_t input_pos_ = 0;
+
+    std::unique_ptr<seqlock> timestamp_;
+    std::atomic<bool> has_timestamp_ = false;
+    std::uint64_t position_ = 0;
+
+    audio::timestamp::clock::time_point time_of(std::uint64_t) const;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
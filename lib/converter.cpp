@@ -8,6 +8,7 @@
 #include "audio++/converter.hpp"
 #include "audio++/error.hpp"
 #include "internal.hpp" // audio::to_ma_format
+#include "sample.hpp" // audio::fill_silence, audio::widen_s24, audio::narrow_s24
 
 #include <cassert>
 #include <miniaudio.h>
@@ -56,31 +57,135 @@ converter::converter(const converter_options& options) :
 { }
 
 ////////////////////////////////////////////////////////////////////////////////
-vector converter::process(audio::span data_in)
+vector converter::process(audio::span data_in, bool silent)
 {
     assert(data_in.format() == fmt_in_);
 
+    frames_in_ += data_in.size();
+    if (silent && !store_.size())
+    {
+        // output size as if all input up to now went through the resampler;
+        // this also makes up for its latency at the start of silence
+        auto total_out = frames_in_ * fmt_out_.rate / fmt_in_.rate;
+        auto count_out = total_out > frames_out_ ? total_out - frames_out_ : 0;
+        frames_out_ += count_out;
+        silent_ = true;
+
+        audio::vector data_out{fmt_out_, count_out};
+        fill_silence(data_out.span(0));
+        return data_out;
+    }
+
+    resume();
+
     // append to unprocessed data from the previous call
+    append(data_in);
+
+    // the expected count is only an estimate
+    audio::vector data_out{fmt_out_, expected(store_.size())};
+    data_out.resize(drain(data_out.span(0)));
+
+    return data_out;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+vector converter::process(std::span<const audio::span> data_in)
+{
+    gather(data_in);
+
+    // the expected count is only an estimate
+    audio::vector data_out{fmt_out_, expected(store_.size())};
+    data_out.resize(drain(data_out.span(0)));
+
+    return data_out;
+}
+
+std::size_t converter::process(std::span<const audio::span> data_in, std::span<audio::span> data_out)
+{
+    gather(data_in);
+
+    std::size_t total = 0;
+    for (auto span : data_out)
+    {
+        assert(span.format() == fmt_out_);
+
+        auto count = drain(span);
+        total += count;
+
+        if (count < span.size()) break; // ran out of input
+    }
+    return total;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void converter::gather(std::span<const audio::span> data_in)
+{
+    resume();
+
+    std::size_t count = 0;
+    for (auto& span : data_in)
+    {
+        assert(span.format() == fmt_in_);
+        count += span.size();
+    }
+
+    // one allocation (if any) for the whole batch
+    store_.as_bytes().reserve(store_.size_bytes() + count * fmt_in_.size());
+    for (auto& span : data_in) append(span);
+
+    frames_in_ += count;
+}
+
+void converter::append(audio::span data_in)
+{
+    auto pos = store_.size();
     store_.append(data_in);
 
+    if (fmt_in_.type == s24_32) widen_s24(store_.span(pos));
+}
+
+std::size_t converter::expected(std::size_t count_in) const
+{
     auto converter = static_cast<ma_data_converter*>(converter_.get());
-    ma_uint64 count_in = store_.size(), count_out;
+    ma_uint64 count_out;
 
     auto ev = ma_data_converter_get_expected_output_frame_count(converter, count_in, &count_out);
     if (ev != MA_SUCCESS) throw mini_error{ev, "ma_data_converter_get_expected_output_frame_count()"};
 
-    audio::vector data_out{fmt_out_, count_out};
-    
-    ev = ma_data_converter_process_pcm_frames(converter,
+    return count_out;
+}
+
+std::size_t converter::drain(audio::span data_out)
+{
+    auto converter = static_cast<ma_data_converter*>(converter_.get());
+    ma_uint64 count_in = store_.size(), count_out = data_out.size();
+
+    auto ev = ma_data_converter_process_pcm_frames(converter,
         store_.as_bytes().data(), &count_in,
         data_out.as_bytes().data(), &count_out
     );
     if (ev != MA_SUCCESS) throw mini_error{ev, "ma_converter_process_pcm_frames()"};
 
-    // store unprocessed data
-    store_ = vector{store_.span(count_in, store_.npos)};
+    frames_out_ += count_out;
+    if (fmt_out_.type == s24_32) narrow_s24(data_out.subspan(0, count_out));
 
-    return data_out;
+    // drop processed data in place, so that the buffer is reused
+    auto& bytes = store_.as_bytes();
+    bytes.erase(bytes.begin(), bytes.begin() + count_in * fmt_in_.size());
+
+    return count_out;
+}
+
+void converter::resume()
+{
+    if (silent_)
+    {
+        // the resampler history is all silence now
+        auto converter = static_cast<ma_data_converter*>(converter_.get());
+        auto ev = ma_data_converter_reset(converter);
+        if (ev != MA_SUCCESS) throw mini_error{ev, "ma_data_converter_reset()"};
+        silent_ = false;
+    }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,265 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/decoder.hpp"
+#include "audio++/error.hpp"
+#include "internal.hpp" // audio::to_ma_format
+#include "sample.hpp" // audio::narrow_s24
+
+#include <algorithm>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <miniaudio.h>
+#include <mutex>
+#include <thread>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+auto decoder_create_helper(const std::string& path, const decoder_options& options)
+{
+    auto config = ma_decoder_config_init(
+        to_ma_format(options.fmt.type),
+        options.fmt.chans,
+        options.fmt.rate
+    );
+    config.seekPointCount = options.seek_points;
+
+    auto decoder = new ma_decoder;
+    if (auto ev = ma_decoder_init_file(path.data(), &config, decoder); ev != MA_SUCCESS)
+    {
+        delete decoder;
+        throw audio::mini_error{ev, "ma_decoder_init_file()"};
+    }
+    else return decoder;
+}
+
+void decoder_destroy_helper(void* p)
+{
+    auto decoder = static_cast<ma_decoder*>(p);
+    ma_decoder_uninit(decoder);
+    delete decoder;
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Worker threads shared by all decoders.
+//
+// A decoder is queued whenever it has work to do (see pending()). A worker
+// decodes one chunk for it and queues it again if there is more, so that the
+// decoders are serviced round-robin.
+//
+// Who queues a decoder is decided by its state: only the thread that moves it
+// from idle to queued pushes it. A dying decoder is never idle again.
+//
+struct decoder::pool
+{
+    std::mutex mutex;
+    std::condition_variable cv, done;
+    std::deque<decoder*> queue;
+
+    std::vector<std::thread> threads;
+
+    pool()
+    {
+        auto n = std::clamp(std::thread::hardware_concurrency(), 1u, 4u);
+        for (unsigned i = 0; i < n; ++i) threads.emplace_back(&pool::run, this);
+    }
+
+    // never destroyed, so that decoders with static storage can outlive it
+    static pool& instance()
+    {
+        static auto p = new pool;
+        return *p;
+    }
+
+    // must be called with mutex held
+    void push(decoder* d)
+    {
+        queue.push_back(d);
+        cv.notify_one();
+    }
+
+    void run()
+    {
+        std::unique_lock lock{mutex};
+        for (;;)
+        {
+            cv.wait(lock, [&]{ return !queue.empty(); });
+
+            auto d = queue.front();
+            queue.pop_front();
+
+            d->state_.fetch_xor(queued | busy);
+
+            lock.unlock();
+            d->fill();
+            lock.lock();
+
+            // if there is more to do and nobody else has queued it meanwhile
+            d->state_.fetch_and(~busy);
+            unsigned idle = 0;
+            if (d->pending() && d->state_.compare_exchange_strong(idle, queued)) push(d);
+
+            done.notify_all();
+        }
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+decoder::decoder(const std::string& path, const decoder_options& options) :
+    fmt_{options.fmt}, capacity_{options.buffer}, chunk_{std::min(options.chunk, options.buffer)},
+    decoder_{ decoder_create_helper(path, options), &decoder_destroy_helper },
+    ring_(capacity_ * fmt_.size())
+{
+    assert(capacity_ && chunk_);
+
+    // not all formats know their length up front
+    ma_uint64 length;
+    if (ma_decoder_get_length_in_pcm_frames(static_cast<ma_decoder*>(decoder_.get()), &length) == MA_SUCCESS)
+        length_ = length;
+
+    post();
+}
+
+decoder::~decoder()
+{
+    auto& p = pool::instance();
+    std::unique_lock lock{p.mutex};
+
+    // nobody can queue it from now on
+    if (state_.fetch_or(dying) & queued)
+    {
+        std::erase(p.queue, this);
+        state_.fetch_and(~queued);
+    }
+    p.done.wait(lock, [&]{ return !(state_ & (queued | busy)); });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+span decoder::read(std::size_t count)
+{
+    if (seeking()) return span{fmt_, ring_.data(), 0};
+
+    auto head = head_.load(std::memory_order_acquire);
+    auto tail = tail_.load(std::memory_order_relaxed);
+
+    auto off = tail % capacity_;
+    count = std::min({ count, head - tail, capacity_ - off });
+
+    return span{fmt_, ring_.data() + off * fmt_.size(), count};
+}
+
+void decoder::consume(std::size_t count)
+{
+    // sequentially consistent, see decoder::post
+    tail_.store(tail_.load(std::memory_order_relaxed) + count);
+    pos_ += count;
+    post();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void decoder::seek(std::uint64_t frame)
+{
+    seek_to_.store(frame, std::memory_order_relaxed);
+    seek_gen_.fetch_add(1);
+    pos_ = frame;
+
+    post();
+}
+
+bool decoder::seeking() noexcept
+{
+    auto gen = seek_gen_.load(std::memory_order_relaxed);
+    if (applied_gen_ == gen) return false;
+    if (done_gen_.load(std::memory_order_acquire) != gen) return true;
+
+    // skip over stale data decoded before the seek
+    tail_.store(seek_head_.load(std::memory_order_relaxed));
+    applied_gen_ = gen;
+
+    post();
+    return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+bool decoder::eof() const noexcept
+{
+    return applied_gen_ == seek_gen_.load(std::memory_order_relaxed) &&
+        eof_.load(std::memory_order_acquire) &&
+        tail_.load(std::memory_order_relaxed) == head_.load(std::memory_order_acquire);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Hand the decoder over to the pool if it is idle and has work to do.
+//
+// The caller has just changed tail_ or seek_gen_, and a worker that has just
+// finished with the decoder clears busy and then calls pending(). All of these
+// are sequentially consistent, so either the worker sees the change or the
+// caller sees the decoder idle and queues it itself.
+void decoder::post()
+{
+    unsigned idle = 0;
+    if (state_ || !pending() || !state_.compare_exchange_strong(idle, queued)) return;
+
+    auto& p = pool::instance();
+    std::lock_guard lock{p.mutex};
+    p.push(this);
+}
+
+bool decoder::pending() const noexcept
+{
+    if (seek_gen_ != done_gen_) return true;
+
+    auto free = capacity_ - (head_ - tail_);
+    return !eof_ && free >= chunk_;
+}
+
+// called by the pool with busy set
+void decoder::fill()
+{
+    auto decoder = static_cast<ma_decoder*>(decoder_.get());
+
+    if (auto g = seek_gen_.load(std::memory_order_acquire); g != gen_)
+    {
+        gen_ = g;
+        auto ev = ma_decoder_seek_to_pcm_frame(decoder, seek_to_.load(std::memory_order_relaxed));
+
+        eof_.store(ev != MA_SUCCESS, std::memory_order_relaxed);
+        seek_head_.store(head_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        done_gen_.store(gen_, std::memory_order_release);
+        return;
+    }
+
+    auto head = head_.load(std::memory_order_relaxed);
+    auto tail = tail_.load(std::memory_order_acquire);
+    auto free = capacity_ - (head - tail);
+    if (eof_.load(std::memory_order_relaxed) || free < chunk_) return;
+
+    auto off = head % capacity_;
+    auto count = std::min({ chunk_, free, capacity_ - off });
+
+    ma_uint64 done = 0;
+    auto data = ring_.data() + off * fmt_.size();
+    auto ev = ma_decoder_read_pcm_frames(decoder, data, count, &done);
+
+    // decoded in s32 in lieu of s24_32
+    if (fmt_.type == s24_32) narrow_s24(span{fmt_, data, done});
+
+    head_.store(head + done, std::memory_order_release);
+    if (ev != MA_SUCCESS || done < count) eof_.store(true, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
@@ -5,11 +5,10 @@
 // Distributed under the GNU GPL license. See the LICENSE.md file for details.
 
 ////////////////////////////////////////////////////////////////////////////////
+#include "audio++/alsa_backend.hpp"
 #include "audio++/device.hpp"
 #include "audio++/error.hpp"
 
-#include <alsa/asoundlib.h>
-
 ////////////////////////////////////////////////////////////////////////////////
 namespace audio
 {
@@ -18,34 +17,37 @@ namespace audio
 namespace
 {
 
-auto pcm_open_helper(std::string_view name, int stream, int mode)
+auto check_backend_helper(std::unique_ptr<audio::backend> backend, audio::stream stream)
 {
-    snd_pcm_t* pcm;
-    auto ev = snd_pcm_open(&pcm, name.data(), static_cast<snd_pcm_stream_t>(stream), mode);
-    if (ev) throw alsa_error{ev, "snd_pcm_open()"};
-    return pcm;
+    if (!backend) throw audio::error{std::make_error_code(std::errc::invalid_argument), "device: null backend"};
+    if (backend->stream() != stream) throw audio::error{std::make_error_code(std::errc::invalid_argument), "device: wrong stream direction"};
+    return backend;
 }
 
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-device::device(std::string name, int stream, int mode) :
-    pcm_{ pcm_open_helper(name, stream, mode), &snd_pcm_close }, name_{std::move(name)}, params_{&*pcm_}
+device::device(std::unique_ptr<audio::backend> backend, audio::stream stream) :
+    backend_{ check_backend_helper(std::move(backend), stream) }, params_{&*backend_}
 { }
 
 ////////////////////////////////////////////////////////////////////////////////
-capture::capture(std::string name) : device{std::move(name), SND_PCM_STREAM_CAPTURE, 0} { }
-capture::capture(card c) : device{c, SND_PCM_STREAM_CAPTURE, 0} { }
+capture::capture(std::string name) : capture{std::make_unique<alsa_backend>(std::move(name), stream::capture)} { }
+capture::capture(card c) : capture{hw_name(c)} { }
+
+capture::capture(std::string name, nonblock_t) : capture{std::make_unique<alsa_backend>(std::move(name), stream::capture, nonblock)} { }
+capture::capture(card c, nonblock_t) : capture{hw_name(c), nonblock} { }
 
-capture::capture(std::string name, nonblock_t) : device{std::move(name), SND_PCM_STREAM_CAPTURE, SND_PCM_NONBLOCK} { }
-capture::capture(card c, nonblock_t) : device{c, SND_PCM_STREAM_CAPTURE, SND_PCM_NONBLOCK} { }
+capture::capture(std::unique_ptr<audio::backend> backend) : device{std::move(backend), stream::capture} { }
 
 ////////////////////////////////////////////////////////////////////////////////
-playback::playback(std::string name) : device{std::move(name), SND_PCM_STREAM_PLAYBACK, 0} { }
-playback::playback(card c) : device{c, SND_PCM_STREAM_PLAYBACK, 0} { }
+playback::playback(std::string name) : playback{std::make_unique<alsa_backend>(std::move(name), stream::playback)} { }
+playback::playback(card c) : playback{hw_name(c)} { }
+
+playback::playback(std::string name, nonblock_t) : playback{std::make_unique<alsa_backend>(std::move(name), stream::playback, nonblock)} { }
+playback::playback(card c, nonblock_t) : playback{hw_name(c), nonblock} { }
 
-playback::playback(std::string name, nonblock_t) : device{std::move(name), SND_PCM_STREAM_PLAYBACK, SND_PCM_NONBLOCK} { }
-playback::playback(card c, nonblock_t) : device{c, SND_PCM_STREAM_PLAYBACK, SND_PCM_NONBLOCK} { }
+playback::playback(std::unique_ptr<audio::backend> backend) : device{std::move(backend), stream::playback} { }
 
 ////////////////////////////////////////////////////////////////////////////////
 }
@@ -26,6 +26,9 @@ constexpr auto to_ma_format(audio::type type)
         case s24: return ma_format_s24;
         case s32: return ma_format_s32;
         case f32: return ma_format_f32;
+        // miniaudio has no 24-in-32 format, so it is processed as s32
+        // and converted with audio::widen_s24 and audio::narrow_s24
+        case s24_32: return ma_format_s32;
         default : return ma_format_unknown;
     }
 }
@@ -0,0 +1,225 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/meter.hpp"
+#include "sample.hpp"
+#include "seqlock.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numbers>
+#include <tuple>
+#include <utility>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+// K-weighting filter coefficients from ITU-R BS.1770,
+// re-calculated for an arbitrary sample rate
+
+auto shelf_coeffs(double rate)
+{
+    constexpr double f0 = 1681.974450955533, G = 3.999843853973347, Q = 0.7071752369554196;
+
+    auto K = std::tan(std::numbers::pi * f0 / rate);
+    auto Vh = std::pow(10., G / 20);
+    auto Vb = std::pow(Vh, 0.4996667741545416);
+    auto a0 = 1 + K / Q + K * K;
+
+    return std::tuple{
+        (Vh + Vb * K / Q + K * K) / a0,
+        2 * (K * K - Vh) / a0,
+        (Vh - Vb * K / Q + K * K) / a0,
+        2 * (K * K - 1) / a0,
+        (1 - K / Q + K * K) / a0
+    };
+}
+
+auto hipass_coeffs(double rate)
+{
+    constexpr double f0 = 38.13547087602444, Q = 0.5003270373238773;
+
+    auto K = std::tan(std::numbers::pi * f0 / rate);
+    auto a0 = 1 + K / Q + K * K;
+
+    return std::tuple{ 1., -2., 1., 2 * (K * K - 1) / a0, (1 - K / Q + K * K) / a0 };
+}
+
+// Reductions with independent partial results per lane, so that the
+// compiler can vectorize them without -ffast-math.
+template<typename Fn, typename Op>
+float reduce(const float* __restrict p, std::size_t n, Fn fn, Op op)
+{
+    constexpr std::size_t lanes = 8;
+    float acc[lanes] { };
+
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes)
+        for (std::size_t l = 0; l < lanes; ++l) acc[l] = fn(acc[l], p[i + l]);
+    for (; i < n; ++i) acc[0] = fn(acc[0], p[i]);
+
+    for (std::size_t l = 1; l < lanes; ++l) acc[0] = op(acc[0], acc[l]);
+    return acc[0];
+}
+
+inline auto fold_peak(float acc, float x) { return std::max(acc, std::abs(x)); }
+inline auto fold_sq(float acc, float x) { return acc + x * x; }
+
+inline auto max(float x, float y) { return std::max(x, y); }
+inline auto sum(float x, float y) { return x + y; }
+
+inline auto to_lufs(double ms) { return static_cast<float>(-0.691 + 10 * std::log10(ms)); }
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+meter::meter(audio::format fmt) : fmt_{fmt},
+    block_{std::max<std::size_t>(fmt.rate / 10, 1)}, // 100 ms
+    chans_(fmt.chans),
+    data_(block_ * fmt.chans), plane_(block_), levels_(fmt.chans),
+    snapshot_{std::make_unique<seqlock>(sizeof(level) * fmt.chans)}
+{
+    auto [sb0, sb1, sb2, sa1, sa2] = shelf_coeffs(fmt.rate);
+    auto [hb0, hb1, hb2, ha1, ha2] = hipass_coeffs(fmt.rate);
+
+    for (auto& chan : chans_)
+    {
+        chan.shelf = biquad{ sb0, sb1, sb2, sa1, sa2 };
+        chan.hipass = biquad{ hb0, hb1, hb2, ha1, ha2 };
+    }
+
+    auto inf = std::numeric_limits<float>::infinity();
+    std::fill(levels_.begin(), levels_.end(), level{ 0, 0, -inf, -inf });
+    snapshot_->store(levels_.data());
+}
+
+meter::~meter() { }
+
+////////////////////////////////////////////////////////////////////////////////
+void meter::process(audio::span span, bool silent)
+{
+    assert(span.format() == fmt_);
+
+    if (silent)
+        for (auto& chan : chans_)
+        {
+            // filter response to silence decays to 0
+            chan.shelf.z1 = chan.shelf.z2 = 0;
+            chan.hipass.z1 = chan.hipass.z2 = 0;
+        }
+
+    while (span.size())
+    {
+        // process up to the end of the current block
+        auto chunk = span.subspan(0, block_ - count_);
+        auto n = chunk.size();
+        if (!silent) update(chunk);
+
+        count_ += n;
+        if (count_ == block_)
+        {
+            publish();
+            count_ = 0;
+        }
+
+        span = span.subspan(n);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::vector<level> meter::levels() const
+{
+    std::vector<level> levels(fmt_.chans);
+    snapshot_->load(levels.data());
+    return levels;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void meter::update(audio::span chunk)
+{
+    auto n = chunk.size();
+    to_float(chunk, data_.data());
+
+    for (std::size_t c = 0; c < chans_.size(); ++c)
+    {
+        // de-interleave for contiguous access in the inner loops
+        auto in = data_.data() + c;
+        for (std::size_t i = 0; i < n; ++i) plane_[i] = in[i * fmt_.chans];
+
+        update(plane_.data(), n, chans_[c]);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void meter::update(float* __restrict plane, std::size_t n, channel& chan)
+{
+    auto peak = reduce(plane, n, fold_peak, max);
+    auto sq = reduce(plane, n, fold_sq, sum);
+
+    // the filters are recursive, but after them the K-weighted
+    // sum of squares is again a plain reduction
+    for (auto* f : { &chan.shelf, &chan.hipass })
+    {
+        auto [b0, b1, b2, a1, a2, z1, z2] = *f;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            double x = plane[i], y = b0 * x + z1;
+            z1 = b1 * x - a1 * y + z2;
+            z2 = b2 * x - a2 * y;
+            plane[i] = static_cast<float>(y);
+        }
+        f->z1 = z1; f->z2 = z2;
+    }
+
+    auto wsq = reduce(plane, n, fold_sq, sum);
+
+    chan.acc.peak = std::max(chan.acc.peak, peak);
+    chan.acc.sq += sq;
+    chan.acc.wsq += wsq;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void meter::publish()
+{
+    for (std::size_t c = 0; c < chans_.size(); ++c)
+    {
+        auto& chan = chans_[c];
+        chan.hist[hist_pos_] = std::exchange(chan.acc, block{ });
+
+        block m, s;
+        for (std::size_t i = 0; i < short_term_blocks; ++i)
+        {
+            auto& b = chan.hist[(hist_pos_ + short_term_blocks - i) % short_term_blocks];
+            if (i < momentary_blocks)
+            {
+                m.peak = std::max(m.peak, b.peak);
+                m.sq += b.sq;
+                m.wsq += b.wsq;
+            }
+            s.wsq += b.wsq;
+        }
+
+        auto& level = levels_[c];
+        level.peak = m.peak;
+        level.rms = static_cast<float>(std::sqrt(m.sq / (momentary_blocks * block_)));
+        level.momentary = to_lufs(m.wsq / (momentary_blocks * block_));
+        level.short_term = to_lufs(s.wsq / (short_term_blocks * block_));
+    }
+    hist_pos_ = (hist_pos_ + 1) % short_term_blocks;
+
+    snapshot_->store(levels_.data());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/error.hpp"
+#include "audio++/mini_backend.hpp"
+#include "internal.hpp" // audio::to_ma_format
+#include "sample.hpp" // audio::fill_silence, audio::widen_s24, audio::narrow_s24
+
+#include <cstring>
+#include <utility>
+#include <miniaudio.h>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+void device_destroy_helper(void* p)
+{
+    auto device = static_cast<ma_device*>(p);
+    if (device)
+    {
+        ma_device_uninit(device);
+        delete device;
+    }
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+mini_backend::mini_backend(audio::stream stream) :
+    name_{"default"}, stream_{stream}, fmt_{ }, device_{nullptr, &device_destroy_helper}
+{ }
+
+mini_backend::~mini_backend() { device_.reset(); }
+
+////////////////////////////////////////////////////////////////////////////////
+void mini_backend::start(audio::format fmt, std::size_t period, callback cb)
+{
+    // errors of the previous run are of no interest anymore
+    device_.reset();
+    error_ = nullptr;
+    failed_ = false;
+
+    fmt_ = fmt;
+    cb_ = std::move(cb);
+
+    auto capture = stream_ == stream::capture;
+
+    if (capture && fmt.type == s24_32) scratch_.emplace(fmt, period);
+    else scratch_.reset();
+
+    auto config = ma_device_config_init(capture ? ma_device_type_capture : ma_device_type_playback);
+
+    // playback and capture are of different (anonymous) types
+    if (capture)
+    {
+        config.capture.format = to_ma_format(fmt.type);
+        config.capture.channels = fmt.chans;
+    }
+    else
+    {
+        config.playback.format = to_ma_format(fmt.type);
+        config.playback.channels = fmt.chans;
+    }
+
+    config.sampleRate = fmt.rate;
+    config.periodSizeInFrames = static_cast<ma_uint32>(period);
+    config.dataCallback = [](ma_device* device, void* out, const void* in, ma_uint32 count)
+    {
+        static_cast<mini_backend*>(device->pUserData)->process(out, in, count);
+    };
+    config.pUserData = this;
+
+    auto device = new ma_device;
+    if (auto ev = ma_device_init(nullptr, &config, device); ev != MA_SUCCESS)
+    {
+        delete device;
+        throw mini_error{ev, "ma_device_init()"};
+    }
+    device_.reset(device);
+
+    if (auto ev = ma_device_start(device); ev != MA_SUCCESS)
+    {
+        device_.reset();
+        throw mini_error{ev, "ma_device_start()"};
+    }
+}
+
+void mini_backend::stop()
+{
+    // ma_device_uninit stops the device and waits for the callback to return
+    device_.reset();
+    if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void mini_backend::process(void* out, const void* in, std::size_t count) try
+{
+    if (failed_.load(std::memory_order_relaxed))
+    {
+        if (stream_ == stream::playback) fill_silence(span{fmt_, out, count});
+    }
+    else if (stream_ == stream::playback)
+    {
+        auto data = span{fmt_, out, count};
+        cb_(data);
+
+        // the device runs in s32 in lieu of s24_32
+        if (fmt_.type == s24_32) widen_s24(data);
+    }
+    else if (scratch_)
+    {
+        // never write through in; miniaudio may deliver more than a period
+        auto src = static_cast<const char*>(in);
+        for (std::size_t done = 0; done < count; )
+        {
+            auto data = scratch_->span(0, count - done);
+            std::memcpy(data.as_bytes().data(), src + done * fmt_.size(), data.size_bytes());
+
+            narrow_s24(data);
+            cb_(data);
+
+            done += data.size();
+        }
+    }
+    else cb_(span{fmt_, in, count});
+}
+catch (...)
+{
+    // can't unwind through miniaudio; handed over to stop() instead
+    error_ = std::current_exception();
+    failed_.store(true, std::memory_order_release);
+
+    if (stream_ == stream::playback) fill_silence(span{fmt_, out, count});
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,302 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "sample.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+template<typename T>
+inline T load(const char* p) noexcept
+{
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+template<typename T>
+inline void store(char* p, T value) noexcept
+{
+    std::memcpy(p, &value, sizeof(T));
+}
+
+// packed little-endian 24-bit sample
+struct int24 { std::uint8_t b[3]; };
+
+inline std::int32_t from_int24(int24 x) noexcept
+{
+    auto v = std::uint32_t{x.b[0]} << 8 | std::uint32_t{x.b[1]} << 16 | std::uint32_t{x.b[2]} << 24;
+    return static_cast<std::int32_t>(v) >> 8;
+}
+
+inline int24 to_int24(std::int32_t x) noexcept
+{
+    auto v = static_cast<std::uint32_t>(x);
+    return int24{{ static_cast<std::uint8_t>(v), static_cast<std::uint8_t>(v >> 8), static_cast<std::uint8_t>(v >> 16) }};
+}
+
+// sign-extend 24-bit sample in the lower 3 bytes of a 32-bit word
+inline std::int32_t from_int24_32(std::int32_t x) noexcept
+{
+    return static_cast<std::int32_t>(static_cast<std::uint32_t>(x) << 8) >> 8;
+}
+
+// count of samples converted at a time via a temporary buffer
+constexpr std::size_t block = 256;
+
+template<typename T, typename Fn>
+void to_float_helper(const char* __restrict in, float* __restrict out, std::size_t n, Fn fn)
+{
+    for (std::size_t i = 0; i < n; ++i) out[i] = fn(load<T>(in + i * sizeof(T)));
+}
+
+template<typename T, typename Fn>
+void from_float_helper(const float* __restrict in, char* __restrict out, std::size_t n, Fn fn)
+{
+    for (std::size_t i = 0; i < n; ++i) store<T>(out + i * sizeof(T), fn(std::clamp(in[i], -1.f, 1.f)));
+}
+
+template<typename T, typename Fn>
+auto max_abs_helper(const char* __restrict in, std::size_t n, Fn fn)
+{
+    // independent partial results per lane let the compiler
+    // vectorize the reduction even for floats
+    constexpr std::size_t lanes = 16;
+    decltype(fn(T{ })) acc[lanes] { };
+
+    std::size_t i = 0;
+    for (; i + lanes <= n; i += lanes)
+        for (std::size_t l = 0; l < lanes; ++l)
+            acc[l] = std::max(acc[l], fn(load<T>(in + (i + l) * sizeof(T))));
+    for (; i < n; ++i) acc[0] = std::max(acc[0], fn(load<T>(in + i * sizeof(T))));
+
+    return *std::max_element(acc, acc + lanes);
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void to_float(audio::span span, float* out)
+{
+    auto in = span.as_bytes().data();
+    auto n = span.size() * span.format().chans;
+
+    switch (span.format().type)
+    {
+    case u8:
+        to_float_helper<std::uint8_t>(in, out, n, [](std::uint8_t x){ return (x - 128) * (1.f / 128); });
+        break;
+
+    case s16:
+        to_float_helper<std::int16_t>(in, out, n, [](std::int16_t x){ return x * (1.f / 32768); });
+        break;
+
+    case s24:
+        // unpack in blocks, so that the scaling loop vectorizes
+        for (std::size_t i = 0; i < n; i += block)
+        {
+            auto count = std::min(block, n - i);
+            char tmp[block * 4];
+
+            unpack_s24(in + i * 3, tmp, count);
+            to_float_helper<std::int32_t>(tmp, out + i, count, [](std::int32_t x){ return x * (1.f / 8388608); });
+        }
+        break;
+
+    case s24_32:
+        to_float_helper<std::int32_t>(in, out, n, [](std::int32_t x){ return from_int24_32(x) * (1.f / 8388608); });
+        break;
+
+    case s32:
+        to_float_helper<std::int32_t>(in, out, n, [](std::int32_t x){ return x * (1.f / 2147483648.f); });
+        break;
+
+    case f32:
+        std::memcpy(out, in, n * sizeof(float));
+        break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void from_float(const float* in, audio::span span)
+{
+    auto out = span.as_bytes().data();
+    auto n = span.size() * span.format().chans;
+
+    switch (span.format().type)
+    {
+    case u8:
+        from_float_helper<std::uint8_t>(in, out, n, [](float x)
+        {
+            return static_cast<std::uint8_t>(std::min(x * 128 + 128.5f, 255.f));
+        });
+        break;
+
+    case s16:
+        from_float_helper<std::int16_t>(in, out, n, [](float x)
+        {
+            return static_cast<std::int16_t>(std::min(x * 32768, 32767.f));
+        });
+        break;
+
+    case s24:
+        for (std::size_t i = 0; i < n; i += block)
+        {
+            auto count = std::min(block, n - i);
+            char tmp[block * 4];
+
+            from_float_helper<std::int32_t>(in + i, tmp, count, [](float x)
+            {
+                return static_cast<std::int32_t>(std::min(x * 8388608, 8388607.f));
+            });
+            pack_s24(tmp, out + i * 3, count);
+        }
+        break;
+
+    case s24_32:
+        from_float_helper<std::int32_t>(in, out, n, [](float x)
+        {
+            return static_cast<std::int32_t>(std::min(x * 8388608, 8388607.f));
+        });
+        break;
+
+    case s32:
+        from_float_helper<std::int32_t>(in, out, n, [](float x)
+        {
+            // 2147483647.f rounds up to 2^31, so clamp in double
+            return static_cast<std::int32_t>(std::min(x * 2147483648., 2147483647.));
+        });
+        break;
+
+    case f32:
+        std::memcpy(out, in, n * sizeof(float));
+        break;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void fill_silence(audio::span span)
+{
+    auto bytes = span.as_bytes();
+    std::ranges::fill(bytes, span.format().type == u8 ? '\x80' : '\0');
+}
+
+////////////////////////////////////////////////////////////////////////////////
+float max_abs(audio::span span)
+{
+    auto in = span.as_bytes().data();
+    auto n = span.size() * span.format().chans;
+
+    switch (span.format().type)
+    {
+    case u8:
+        return max_abs_helper<std::uint8_t>(in, n, [](std::uint8_t x)
+        {
+            return static_cast<std::int32_t>(x > 128 ? x - 128 : 128 - x);
+        }) * (1.f / 128);
+
+    case s16:
+        return max_abs_helper<std::int16_t>(in, n, [](std::int16_t x)
+        {
+            return std::abs(static_cast<std::int32_t>(x));
+        }) * (1.f / 32768);
+
+    case s24:
+        return max_abs_helper<int24>(in, n, [](int24 x){ return std::abs(from_int24(x)); }) * (1.f / 8388608);
+
+    case s24_32:
+        return max_abs_helper<std::int32_t>(in, n, [](std::int32_t x)
+        {
+            return std::abs(from_int24_32(x));
+        }) * (1.f / 8388608);
+
+    case s32:
+        return max_abs_helper<std::int32_t>(in, n, [](std::int32_t x)
+        {
+            // avoid overflow of abs(INT32_MIN)
+            return static_cast<std::uint32_t>(x < 0 ? -static_cast<std::int64_t>(x) : x);
+        }) * (1.f / 2147483648.f);
+
+    case f32:
+        return max_abs_helper<float>(in, n, [](float x){ return std::abs(x); });
+    }
+    return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void pack_s24(const char* __restrict in, char* __restrict out, std::size_t n)
+{
+    std::size_t i = 0;
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        // 4 samples -> 3 words without byte shuffling
+        for (; i + 4 <= n; i += 4)
+        {
+            auto x0 = load<std::uint32_t>(in + i * 4     ), x1 = load<std::uint32_t>(in + i * 4 +  4);
+            auto x2 = load<std::uint32_t>(in + i * 4 +  8), x3 = load<std::uint32_t>(in + i * 4 + 12);
+
+            store<std::uint32_t>(out + i * 3    , (x0 & 0xffffff) | x1 << 24);
+            store<std::uint32_t>(out + i * 3 + 4, (x1 >> 8 & 0xffff) | x2 << 16);
+            store<std::uint32_t>(out + i * 3 + 8, (x2 >> 16 & 0xff) | x3 << 8);
+        }
+    }
+    for (; i < n; ++i) store<int24>(out + i * 3, to_int24(load<std::int32_t>(in + i * 4)));
+}
+
+void unpack_s24(const char* __restrict in, char* __restrict out, std::size_t n)
+{
+    std::size_t i = 0;
+    if constexpr (std::endian::native == std::endian::little)
+    {
+        // 3 words -> 4 samples, sign-extended with an arithmetic shift
+        for (; i + 4 <= n; i += 4)
+        {
+            auto w0 = load<std::uint32_t>(in + i * 3), w1 = load<std::uint32_t>(in + i * 3 + 4);
+            auto w2 = load<std::uint32_t>(in + i * 3 + 8);
+
+            store<std::int32_t>(out + i * 4     , static_cast<std::int32_t>(w0 << 8) >> 8);
+            store<std::int32_t>(out + i * 4 +  4, static_cast<std::int32_t>(w1 << 16 | (w0 >> 24) << 8) >> 8);
+            store<std::int32_t>(out + i * 4 +  8, static_cast<std::int32_t>(w2 << 24 | (w1 >> 16) << 8) >> 8);
+            store<std::int32_t>(out + i * 4 + 12, static_cast<std::int32_t>(w2) >> 8);
+        }
+    }
+    for (; i < n; ++i) store<std::int32_t>(out + i * 4, from_int24(load<int24>(in + i * 3)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void widen_s24(audio::span span)
+{
+    auto p = span.as_bytes().data();
+    auto n = span.size() * span.format().chans;
+
+    for (std::size_t i = 0; i < n; ++i)
+        store<std::uint32_t>(p + i * 4, load<std::uint32_t>(p + i * 4) << 8);
+}
+
+void narrow_s24(audio::span span)
+{
+    auto p = span.as_bytes().data();
+    auto n = span.size() * span.format().chans;
+
+    for (std::size_t i = 0; i < n; ++i)
+        store<std::int32_t>(p + i * 4, load<std::int32_t>(p + i * 4) >> 8);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,51 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef AUDIO_SAMPLE_HPP
+#define AUDIO_SAMPLE_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/span.hpp"
+#include <cstddef>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// Convert interleaved samples of any audio::type to/from interleaved floats
+// in the [-1, 1) range. The loops are kept branch-free, so that the compiler
+// can vectorize them.
+//
+// `out` (resp. `in`) must hold at least span.size() * span.format().chans
+// floats.
+//
+void to_float(audio::span, float* out);
+void from_float(const float* in, audio::span);
+
+// Fill span with silence (which for unsigned types is not 0).
+void fill_silence(audio::span);
+
+// Get maximum absolute sample value of a span across all channels
+// in the [0, 1] range without converting it to floats first.
+float max_abs(audio::span);
+
+// Pack n samples of type s24_32 into s24 and unpack them back (with sign
+// extension). Four samples are processed at a time as three 32-bit words.
+void pack_s24(const char* in, char* out, std::size_t n);
+void unpack_s24(const char* in, char* out, std::size_t n);
+
+// Convert s24_32 samples to s32 and back in place. These are used where
+// miniaudio has to work in s32 in lieu of s24_32 (see audio::to_ma_format).
+void widen_s24(audio::span);
+void narrow_s24(audio::span);
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
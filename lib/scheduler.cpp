@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/scheduler.hpp"
+#include "sample.hpp" // audio::to_float, audio::from_float
+
+#include <algorithm>
+#include <cassert>
+#include <optional>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+struct scheduler::clip
+{
+    std::uint64_t start;
+    std::optional<audio::vector> data;
+    scheduler::source src;
+
+    std::size_t done = 0; // frames played so far
+};
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+template<typename T>
+class spsc_queue
+{
+public:
+    explicit spsc_queue(std::size_t capacity) : slots_(capacity) { }
+
+    bool push(T value) noexcept
+    {
+        auto head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == slots_.size()) return false;
+
+        slots_[head % slots_.size()] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    std::optional<T> pop() noexcept
+    {
+        auto tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) return std::nullopt;
+
+        auto value = slots_[tail % slots_.size()];
+        tail_.store(tail + 1, std::memory_order_release);
+        return value;
+    }
+
+private:
+    std::vector<T> slots_;
+    std::atomic<std::uint64_t> head_ = 0, tail_ = 0;
+};
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+struct scheduler::state
+{
+    std::size_t capacity, live = 0; // live is owned by the scheduling side
+
+    // clips handed over to and back from the audio thread
+    spsc_queue<clip*> incoming, retired;
+
+    // owned by the audio thread, reserved up front
+    std::vector<clip*> pending, active; // pending is a min-heap on clip::start
+    std::vector<float> mix, tmp;
+    audio::vector buffer;
+
+    state(audio::format fmt, std::size_t period, std::size_t capacity) :
+        capacity{capacity}, incoming{capacity}, retired{capacity},
+        mix(period * fmt.chans), tmp(period * fmt.chans), buffer{fmt, period}
+    {
+        pending.reserve(capacity);
+        active.reserve(capacity);
+    }
+
+    ~state()
+    {
+        while (auto c = incoming.pop()) delete *c;
+        while (auto c = retired.pop()) delete *c;
+        for (auto c : pending) delete c;
+        for (auto c : active) delete c;
+    }
+
+    static bool later(const clip* x, const clip* y) noexcept { return x->start > y->start; }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+scheduler::scheduler(const scheduler_options& options) :
+    fmt_{options.fmt}, period_{options.period},
+    state_{ std::make_unique<state>(options.fmt, options.period, options.capacity) }
+{
+    assert(period_ && options.capacity);
+}
+
+// the playback device has to be stopped before the scheduler is destroyed
+scheduler::~scheduler() { }
+
+////////////////////////////////////////////////////////////////////////////////
+bool scheduler::schedule(std::uint64_t start, audio::vector data)
+{
+    assert(data.format() == fmt_);
+    return submit(std::unique_ptr<clip>{ new clip{start, std::move(data), { }} });
+}
+
+bool scheduler::schedule(std::uint64_t start, source src)
+{
+    assert(src);
+    return submit(std::unique_ptr<clip>{ new clip{start, std::nullopt, std::move(src)} });
+}
+
+bool scheduler::submit(std::unique_ptr<clip> c)
+{
+    std::lock_guard lock{mutex_};
+    auto& st = *state_;
+
+    // free clips that have finished playing
+    while (auto r = st.retired.pop())
+    {
+        delete *r;
+        --st.live;
+    }
+    if (st.live == st.capacity) return false;
+
+    // can't fail, as there are never more than capacity clips in flight
+    st.incoming.push(c.release());
+    ++st.live;
+
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void scheduler::start(audio::playback& dev)
+{
+    dev.start(fmt_, period_, [this](audio::span span){ process(span); });
+}
+
+void scheduler::process(audio::span span)
+{
+    assert(span.format() == fmt_);
+    for (std::size_t pos = 0; pos < span.size(); pos += period_) mix(span.subspan(pos, period_));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void scheduler::mix(audio::span out)
+{
+    auto& st = *state_;
+    std::size_t chans = fmt_.chans, n = out.size();
+
+    auto pos = pos_.load(std::memory_order_relaxed), end = pos + n;
+
+    // O(log n) per clip
+    while (auto c = st.incoming.pop())
+    {
+        st.pending.push_back(*c);
+        std::ranges::push_heap(st.pending, &state::later);
+    }
+    while (!st.pending.empty() && st.pending.front()->start < end)
+    {
+        std::ranges::pop_heap(st.pending, &state::later);
+        st.active.push_back(st.pending.back());
+        st.pending.pop_back();
+    }
+
+    std::fill_n(st.mix.data(), n * chans, 0.f);
+    for (std::size_t i = 0; i < st.active.size(); )
+    {
+        auto c = st.active[i];
+
+        auto off = c->start > pos ? c->start - pos : 0;
+        auto count = n - off;
+
+        std::size_t got;
+        if (c->data)
+        {
+            auto data = c->data->span(c->done, count);
+            got = data.size();
+            to_float(data, st.tmp.data());
+        }
+        else
+        {
+            auto data = st.buffer.span(0, count);
+            got = std::min(c->src(data), count);
+            to_float(data.subspan(0, got), st.tmp.data());
+        }
+
+        auto p = st.mix.data() + off * chans;
+        for (std::size_t k = 0; k < got * chans; ++k) p[k] += st.tmp[k];
+
+        c->done += got;
+        if (c->data ? c->done == c->data->size() : got < count)
+        {
+            // can't fail for the same reason as in submit()
+            st.retired.push(c);
+            st.active[i] = st.active.back();
+            st.active.pop_back();
+        }
+        else ++i;
+    }
+
+    from_float(st.mix.data(), out);
+    pos_.store(end, std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#ifndef AUDIO_SEQLOCK_HPP
+#define AUDIO_SEQLOCK_HPP
+
+////////////////////////////////////////////////////////////////////////////////
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// Single-writer multiple-reader snapshot of `size` bytes.
+//
+// The writer never blocks; readers retry if the snapshot was being updated
+// while they were copying it. The payload is kept in atomic words, so there
+// are no data races even while a reader is retrying.
+//
+class seqlock
+{
+public:
+    ////////////////////
+    explicit seqlock(std::size_t size) :
+        size_{size}, words_{(size + sizeof(word) - 1) / sizeof(word)},
+        data_{std::make_unique<std::atomic<word>[]>(words_)}
+    { }
+
+    void store(const void* p) noexcept
+    {
+        auto seq = seq_.load(std::memory_order_relaxed);
+        seq_.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        auto src = static_cast<const char*>(p);
+        for (std::size_t i = 0; i < words_; ++i)
+        {
+            word w{ };
+            std::memcpy(&w, src + i * sizeof(word), chunk(i));
+            data_[i].store(w, std::memory_order_relaxed);
+        }
+
+        seq_.store(seq + 2, std::memory_order_release);
+    }
+
+    void load(void* p) const noexcept
+    {
+        auto dst = static_cast<char*>(p);
+        for (;;)
+        {
+            auto seq = seq_.load(std::memory_order_acquire);
+            if (seq & 1) continue; // writer in progress
+
+            for (std::size_t i = 0; i < words_; ++i)
+            {
+                auto w = data_[i].load(std::memory_order_relaxed);
+                std::memcpy(dst + i * sizeof(word), &w, chunk(i));
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (seq_.load(std::memory_order_relaxed) == seq) break;
+        }
+    }
+
+private:
+    ////////////////////
+    using word = std::uint64_t;
+
+    std::size_t size_, words_;
+    std::unique_ptr<std::atomic<word>[]> data_;
+    std::atomic<unsigned> seq_{0};
+
+    constexpr std::size_t chunk(std::size_t i) const noexcept
+    {
+        return std::min(sizeof(word), size_ - i * sizeof(word));
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+}
+
+////////////////////////////////////////////////////////////////////////////////
+#endif
@@ -0,0 +1,256 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/error.hpp"
+#include "audio++/shm.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <new>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// Layout of the shared memory: this header followed by the ring.
+//
+// The writer bumps head before it starts overwriting old frames, and tail once
+// the new frames are in place. Readers use tail to find new data, and head to
+// check that what they have read has not been overwritten.
+//
+struct shm_header
+{
+    std::uint32_t magic, version;
+    audio::format fmt;
+    std::uint64_t capacity;
+
+    alignas(64) std::atomic<std::uint64_t> head;
+    alignas(64) std::atomic<std::uint64_t> tail;
+};
+
+static_assert(std::atomic<std::uint64_t>::is_always_lock_free, "Need address-free atomics in shared memory");
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+constexpr std::uint32_t shm_magic = 0x2b2b6175; // "ua++"
+constexpr std::uint32_t shm_version = 1;
+
+constexpr std::size_t data_offset = (sizeof(shm_header) + 63) / 64 * 64;
+
+[[noreturn]] void throw_errno(const char* msg)
+{
+    throw audio::error{errno, std::system_category(), msg};
+}
+
+auto memfd_create_helper(std::size_t size)
+{
+    auto fd = ::memfd_create("audio++", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd < 0) throw_errno("memfd_create()");
+
+    if (::ftruncate(fd, size) < 0)
+    {
+        auto ev = errno;
+        ::close(fd);
+        throw audio::error{ev, std::system_category(), "ftruncate()"};
+    }
+
+    // readers can trust the size (see shm_reader ctor)
+    if (::fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) < 0)
+    {
+        auto ev = errno;
+        ::close(fd);
+        throw audio::error{ev, std::system_category(), "fcntl(F_ADD_SEALS)"};
+    }
+    return fd;
+}
+
+auto mmap_helper(int fd, std::size_t size, int prot)
+{
+    auto p = ::mmap(nullptr, size, prot, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) throw_errno("mmap()");
+    return static_cast<char*>(p);
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+shm_writer::shm_writer(const shm_options& options) : fmt_{options.fmt},
+    size_{data_offset + options.capacity * options.fmt.size()}
+{
+    assert(options.capacity);
+
+    fd_ = memfd_create_helper(size_);
+
+    char* base;
+    try { base = mmap_helper(fd_, size_, PROT_READ | PROT_WRITE); }
+    catch (...) { ::close(fd_); throw; }
+
+    header_ = new (base) shm_header{ shm_magic, shm_version, fmt_, options.capacity, {0}, {0} };
+    data_ = base + data_offset;
+}
+
+shm_writer::~shm_writer()
+{
+    for (auto event_fd : events_) ::close(event_fd);
+    ::munmap(header_, size_);
+    ::close(fd_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+int shm_writer::add_reader()
+{
+    auto event_fd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (event_fd < 0) throw_errno("eventfd()");
+
+    events_.push_back(event_fd);
+    return event_fd;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void shm_writer::write(audio::span span)
+{
+    assert(span.format() == fmt_);
+
+    auto cap = header_->capacity;
+    auto count = span.size();
+    auto tail = header_->tail.load(std::memory_order_relaxed);
+
+    // let readers know which frames are about to be overwritten
+    header_->head.store(tail + count, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    // only the last capacity frames of a large span survive anyway
+    auto skip = count > cap ? count - cap : 0;
+    auto bytes = span.subspan(skip).as_bytes();
+
+    auto pos = (tail + skip) % cap * fmt_.size();
+    auto n = std::min<std::size_t>(bytes.size(), cap * fmt_.size() - pos);
+
+    std::memcpy(data_ + pos, bytes.data(), n);
+    std::memcpy(data_, bytes.data() + n, bytes.size() - n);
+
+    header_->tail.store(tail + count, std::memory_order_release);
+
+    std::uint64_t one = 1;
+    for (auto event_fd : events_)
+    {
+        [[maybe_unused]] auto _ = ::write(event_fd, &one, sizeof(one));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+shm_reader::shm_reader(int fd, int event_fd) : fd_{fd}, event_fd_{event_fd}
+{
+    try
+    {
+        // without the seal the writer could shrink the memfd under us
+        auto seals = ::fcntl(fd_, F_GET_SEALS);
+        if (seals < 0) throw_errno("fcntl(F_GET_SEALS)");
+        if (!(seals & F_SEAL_SHRINK)) throw audio::error{std::make_error_code(std::errc::invalid_argument), "shm_reader: not sealed"};
+
+        struct stat st;
+        if (::fstat(fd_, &st) < 0) throw_errno("fstat()");
+        size_ = st.st_size;
+
+        if (size_ < data_offset) throw audio::error{std::make_error_code(std::errc::invalid_argument), "shm_reader: bad size"};
+        auto base = mmap_helper(fd_, size_, PROT_READ);
+
+        // the header is read once and then only the validated copies are used,
+        // as the writer can still modify it
+        header_ = reinterpret_cast<const shm_header*>(base);
+        auto magic = header_->magic, version = header_->version;
+        fmt_ = header_->fmt;
+        capacity_ = header_->capacity;
+
+        if (magic != shm_magic || version != shm_version || fmt_.chans <= 0 || !fmt_.size() ||
+            !capacity_ || capacity_ > (size_ - data_offset) / fmt_.size())
+        {
+            ::munmap(base, size_);
+            throw audio::error{std::make_error_code(std::errc::invalid_argument), "shm_reader: bad header"};
+        }
+
+        data_ = base + data_offset;
+    }
+    catch (...)
+    {
+        ::close(event_fd_);
+        ::close(fd_);
+        throw;
+    }
+
+    // start with live data
+    pos_ = header_->tail.load(std::memory_order_acquire);
+}
+
+shm_reader::~shm_reader()
+{
+    ::munmap(const_cast<shm_header*>(header_), size_);
+    ::close(event_fd_);
+    ::close(fd_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+span shm_reader::read(std::size_t count)
+{
+    auto cap = capacity_;
+    auto tail = header_->tail.load(std::memory_order_acquire);
+
+    if (tail - pos_ > cap)
+    {
+        // fell too far behind; skip to live data
+        ++overruns_;
+        pos_ = tail;
+    }
+
+    auto off = pos_ % cap;
+    count = std::min({ count, tail - pos_, cap - off });
+
+    return span{fmt_, data_ + off * fmt_.size(), count};
+}
+
+bool shm_reader::consume(std::size_t count)
+{
+    std::atomic_thread_fence(std::memory_order_acquire);
+    auto head = header_->head.load(std::memory_order_relaxed);
+
+    // frames [pos_, pos_ + count) are intact if the writer
+    // hasn't started writing past pos_ + capacity
+    auto intact = head <= pos_ + capacity_;
+    if (!intact) ++overruns_;
+
+    pos_ += count;
+    return intact;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void shm_reader::wait()
+{
+    while (header_->tail.load(std::memory_order_acquire) == pos_)
+    {
+        pollfd pfd{ event_fd_, POLLIN, 0 };
+        if (::poll(&pfd, 1, -1) < 0 && errno != EINTR) throw_errno("poll()");
+
+        std::uint64_t value;
+        [[maybe_unused]] auto _ = ::read(event_fd_, &value, sizeof(value));
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
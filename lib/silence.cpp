@@ -0,0 +1,40 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/silence.hpp"
+#include "sample.hpp" // audio::max_abs
+
+#include <cassert>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+silence_detector::silence_detector(const silence_options& options) :
+    fmt_{options.fmt}, threshold_{options.threshold}, hangover_{options.hangover}
+{ }
+
+////////////////////////////////////////////////////////////////////////////////
+bool silence_detector::process(audio::span span)
+{
+    assert(span.format() == fmt_);
+
+    if (max_abs(span) >= threshold_)
+    {
+        quiet_ = 0;
+        return false;
+    }
+
+    // silent only once the hangover has been passed through
+    auto silent = quiet_ >= hangover_;
+    quiet_ += span.size();
+    return silent;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
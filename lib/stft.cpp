@@ -0,0 +1,273 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/error.hpp"
+#include "audio++/stft.hpp"
+#include "sample.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <new>
+#include <numbers>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+namespace
+{
+
+template<typename T>
+struct aligned_allocator
+{
+    using value_type = T;
+    static constexpr std::align_val_t align{64}; // cache line
+
+    aligned_allocator() = default;
+    template<typename U> aligned_allocator(const aligned_allocator<U>&) noexcept { }
+
+    T* allocate(std::size_t n) { return static_cast<T*>(::operator new(n * sizeof(T), align)); }
+    void deallocate(T* p, std::size_t) noexcept { ::operator delete(p, align); }
+
+    template<typename U> bool operator==(const aligned_allocator<U>&) const noexcept { return true; }
+};
+
+template<typename T>
+using aligned_vector = std::vector<T, aligned_allocator<T>>;
+
+using complex = std::complex<float>;
+
+////////////////////
+// Pre-planned in-place radix-2 FFT.
+//
+// Complex products are spelled out, as std::complex operator* goes through
+// a slow NaN-checking path unless compiled with -ffast-math.
+//
+class fft
+{
+public:
+    explicit fft(std::size_t size) : size_{size}, rev_(size), tw_(size / 2)
+    {
+        auto bits = std::countr_zero(size);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            std::uint32_t r = 0;
+            for (int b = 0; b < bits; ++b) r |= ((i >> b) & 1) << (bits - 1 - b);
+            rev_[i] = r;
+        }
+
+        for (std::size_t k = 0; k < tw_.size(); ++k)
+            tw_[k] = std::polar(1.f, static_cast<float>(-2 * std::numbers::pi * k / size));
+    }
+
+    void forward(complex* x) const noexcept { transform(x); }
+
+    void inverse(complex* x) const noexcept
+    {
+        for (std::size_t i = 0; i < size_; ++i) x[i] = std::conj(x[i]);
+        transform(x);
+
+        auto scale = 1.f / size_;
+        for (std::size_t i = 0; i < size_; ++i) x[i] = { x[i].real() * scale, -x[i].imag() * scale };
+    }
+
+private:
+    std::size_t size_;
+    aligned_vector<std::uint32_t> rev_;
+    aligned_vector<complex> tw_;
+
+    void transform(complex* x) const noexcept
+    {
+        for (std::size_t i = 0; i < size_; ++i)
+            if (i < rev_[i]) std::swap(x[i], x[rev_[i]]);
+
+        for (std::size_t len = 2; len <= size_; len <<= 1)
+        {
+            auto half = len / 2, step = size_ / len;
+            for (std::size_t i = 0; i < size_; i += len)
+                for (std::size_t j = 0; j < half; ++j)
+                {
+                    auto w = tw_[j * step], u = x[i + j], v = x[i + j + half];
+                    complex t{
+                        v.real() * w.real() - v.imag() * w.imag(),
+                        v.real() * w.imag() + v.imag() * w.real()
+                    };
+                    x[i + j] = { u.real() + t.real(), u.imag() + t.imag() };
+                    x[i + j + half] = { u.real() - t.real(), u.imag() - t.imag() };
+                }
+        }
+    }
+};
+
+auto window_helper(audio::window window, std::size_t size)
+{
+    aligned_vector<float> w(size);
+    for (std::size_t n = 0; n < size; ++n)
+    {
+        // periodic windows
+        auto x = 2 * std::numbers::pi * n / size;
+        switch (window)
+        {
+        case rect    : w[n] = 1; break;
+        case hann    : w[n] = static_cast<float>(0.5 - 0.5 * std::cos(x)); break;
+        case hamming : w[n] = static_cast<float>(0.54 - 0.46 * std::cos(x)); break;
+        case blackman: w[n] = static_cast<float>(0.42 - 0.5 * std::cos(x) + 0.08 * std::cos(2 * x)); break;
+        }
+    }
+    return w;
+}
+
+void check_options(const stft_options& options)
+{
+    if (!std::has_single_bit(options.size) || !options.hop || options.size % options.hop)
+        throw audio::error{std::make_error_code(std::errc::invalid_argument), "stft: invalid size or hop"};
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+struct stft::state
+{
+    audio::fft fft;
+    aligned_vector<float> window;
+    float norm;
+
+    // per-channel input history, overlap-add accumulator and finished output
+    std::vector<aligned_vector<float>> in, acc, ready;
+
+    aligned_vector<complex> frame;
+    aligned_vector<float> data; // interleaved samples of the current chunk
+};
+
+////////////////////////////////////////////////////////////////////////////////
+stft::stft(const stft_options& options, callback cb) :
+    fmt_{options.fmt}, size_{options.size}, hop_{options.hop}, cb_{std::move(cb)}
+{
+    check_options(options);
+
+    auto window = window_helper(options.window, size_);
+
+    // scale for analysis * synthesis windows overlapping at hop
+    float sum = 0;
+    for (auto w : window) sum += w * w;
+
+    state_.reset(new state{
+        audio::fft{size_}, std::move(window), hop_ / sum,
+        std::vector(fmt_.chans, aligned_vector<float>(size_)),
+        std::vector(fmt_.chans, aligned_vector<float>(size_)),
+        std::vector(fmt_.chans, aligned_vector<float>(hop_)),
+        aligned_vector<complex>(size_),
+        aligned_vector<float>(hop_ * fmt_.chans)
+    });
+}
+
+stft::~stft() { }
+
+////////////////////////////////////////////////////////////////////////////////
+void stft::process(audio::span data_in, audio::span data_out, bool silent)
+{
+    assert(data_in.format() == fmt_);
+    assert(data_out.format() == fmt_);
+    assert(data_in.size() == data_out.size());
+
+    auto& s = *state_;
+    if (silent)
+    {
+        if (!silent_)
+        {
+            // history is all silence now
+            for (int c = 0; c < fmt_.chans; ++c)
+            {
+                std::ranges::fill(s.in[c], 0.f);
+                std::ranges::fill(s.acc[c], 0.f);
+                std::ranges::fill(s.ready[c], 0.f);
+            }
+            silent_ = true;
+        }
+
+        fill_silence(data_out);
+        pos_ = (pos_ + data_in.size()) % hop_;
+        return;
+    }
+    silent_ = false;
+
+    while (data_in.size())
+    {
+        // process up to the end of the current hop
+        auto chunk_in = data_in.subspan(0, hop_ - pos_);
+        auto chunk_out = data_out.subspan(0, hop_ - pos_);
+        auto n = chunk_in.size();
+
+        to_float(chunk_in, s.data.data());
+        for (int c = 0; c < fmt_.chans; ++c)
+        {
+            auto in = s.in[c].data() + size_ - hop_ + pos_;
+            auto ready = s.ready[c].data() + pos_;
+
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                auto& x = s.data[i * fmt_.chans + c];
+                in[i] = x;
+                x = ready[i];
+            }
+        }
+        from_float(s.data.data(), chunk_out);
+
+        pos_ += n;
+        if (pos_ == hop_)
+        {
+            process_frame();
+            pos_ = 0;
+        }
+
+        data_in = data_in.subspan(n);
+        data_out = data_out.subspan(n);
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void stft::process_frame()
+{
+    auto& s = *state_;
+    auto half = size_ / 2;
+
+    for (int c = 0; c < fmt_.chans; ++c)
+    {
+        auto& in = s.in[c];
+        auto& acc = s.acc[c];
+        auto frame = s.frame.data();
+
+        for (std::size_t n = 0; n < size_; ++n) frame[n] = in[n] * s.window[n];
+        s.fft.forward(frame);
+
+        if (cb_) cb_(c, bins{frame, half + 1});
+
+        // restore hermitian symmetry in case the callback broke it
+        frame[0].imag(0);
+        frame[half].imag(0);
+        for (std::size_t k = 1; k < half; ++k) frame[size_ - k] = std::conj(frame[k]);
+
+        s.fft.inverse(frame);
+        for (std::size_t n = 0; n < size_; ++n) acc[n] += frame[n].real() * s.window[n] * s.norm;
+
+        // first hop of the accumulator is complete now
+        std::copy_n(acc.begin(), hop_, s.ready[c].begin());
+
+        std::copy(acc.begin() + hop_, acc.end(), acc.begin());
+        std::fill(acc.end() - hop_, acc.end(), 0.f);
+
+        std::copy(in.begin() + hop_, in.end(), in.begin());
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}
@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////////////////////////
+// Copyright (c) 2025 Dimitry Ishenko
+// Contact: dimitry (dot) ishenko (at) (gee) mail (dot) com
+//
+// Distributed under the GNU GPL license. See the LICENSE.md file for details.
+
+////////////////////////////////////////////////////////////////////////////////
+#include "audio++/virtual_backend.hpp"
+#include "sample.hpp" // audio::fill_silence
+#include "seqlock.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+////////////////////////////////////////////////////////////////////////////////
+namespace audio
+{
+
+////////////////////////////////////////////////////////////////////////////////
+virtual_backend::virtual_backend(audio::stream stream, std::string name) :
+    name_{std::move(name)}, stream_{stream},
+    timestamp_{ std::make_unique<seqlock>(sizeof(audio::timestamp)) }
+{ }
+
+virtual_backend::~virtual_backend() { }
+
+////////////////////////////////////////////////////////////////////////////////
+void virtual_backend::start(audio::format fmt, std::size_t period, callback cb)
+{
+    assert(period);
+
+    period_ = period;
+    rate_ = fmt.rate;
+    cb_ = std::move(cb);
+
+    position_ = 0;
+    has_timestamp_ = false;
+
+    buffer_.emplace(fmt, period);
+    if (stream_ == stream::playback) recorded_.emplace(fmt);
+
+    // callback for a period is invoked when the clock reaches its end
+    next_ = clock_ + period_;
+}
+
+void virtual_backend::stop() { cb_ = nullptr; }
+
+////////////////////////////////////////////////////////////////////////////////
+void virtual_backend::advance(std::size_t frames)
+{
+    clock_ += frames;
+    while (cb_ && next_ <= clock_)
+    {
+        auto span = buffer_->span(0);
+        fill_silence(span);
+
+        if (stream_ == stream::capture)
+        {
+            if (input_)
+            {
+                auto data = input_->span(input_pos_, period_).as_bytes();
+                std::ranges::copy(data, span.as_bytes().begin());
+
+                input_pos_ += data.size() / span.frame_size();
+                if (input_pos_ == input_->size())
+                {
+                    input_.reset();
+                    input_pos_ = 0;
+                }
+            }
+            cb_(span);
+        }
+        else
+        {
+            cb_(span);
+            recorded_->append(span);
+        }
+
+        position_ += period_;
+
+        audio::timestamp ts{ };
+        ts.trigger = time_of(next_ - position_);
+        ts.time = time_of(next_);
+        ts.audio_time = ts.time - ts.trigger;
+        ts.position = ts.frame = position_;
+        ts.rate = rate_;
+
+        timestamp_->store(&ts);
+        has_timestamp_.store(true, std::memory_order_release);
+
+        next_ += period_;
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+std::optional<audio::timestamp> virtual_backend::timestamp() const
+{
+    if (!has_timestamp_.load(std::memory_order_acquire)) return std::nullopt;
+
+    audio::timestamp ts;
+    timestamp_->load(&ts);
+    return ts;
+}
+
+timestamp::clock::time_point virtual_backend::time_of(std::uint64_t clock) const
+{
+    audio::timestamp epoch{ };
+    epoch.rate = rate_;
+    return epoch.time_of(clock);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+void virtual_backend::feed(audio::span span)
+{
+    assert(!buffer_ || span.format() == buffer_->format());
+
+    if (input_) input_->append(span);
+    else input_.emplace(span);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+}